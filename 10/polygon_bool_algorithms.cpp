@@ -1,30 +1,142 @@
 #include "polygon_bool_algorithms.h"
+#include "point_hash_grid.h"
 #include <algorithm>
-#include <set>
 #include <queue>
 #include <stack>
+#include <limits>
+
+bool PolygonBoolean::rayCrossesEdge(const BoolPoint& p, const BoolPoint& from, const BoolPoint& to) {
+    return ((to.y > p.y) != (from.y > p.y)) &&
+           (p.x < (from.x - to.x) * (p.y - to.y) / (from.y - to.y) + to.x);
+}
 
 bool PolygonBoolean::pointInPolygon(const BoolPoint& p, const PolygonContour& contour) {
     if (contour.points.size() < 3) return false;
 
     bool inside = false;
     for (size_t i = 0, j = contour.points.size() - 1; i < contour.points.size(); j = i++) {
-        if (((contour.points[i].y > p.y) != (contour.points[j].y > p.y)) &&
-            (p.x < (contour.points[j].x - contour.points[i].x) * (p.y - contour.points[i].y) /
-                           (contour.points[j].y - contour.points[i].y) + contour.points[i].x)) {
+        if (rayCrossesEdge(p, contour.points[j], contour.points[i])) {
             inside = !inside;
         }
     }
     return inside;
 }
 
-bool PolygonBoolean::pointInPolygonList(const BoolPoint& p, const std::vector<PolygonContour>& polygons) {
+int PolygonBoolean::windingNumber(const BoolPoint& p, const PolygonContour& contour) {
+    if (contour.points.size() < 3) return 0;
+
+    int winding = 0;
+    for (size_t i = 0, j = contour.points.size() - 1; i < contour.points.size(); j = i++) {
+        if (rayCrossesEdge(p, contour.points[j], contour.points[i])) {
+            winding += contour.points[i].y > contour.points[j].y ? 1 : -1;
+        }
+    }
+    return winding;
+}
+
+bool PolygonBoolean::pointInPolygonList(const BoolPoint& p, const std::vector<PolygonContour>& polygons,
+                                        FillRule rule) {
+    int winding = 0;
+    bool inside = false;
     for (const auto& contour : polygons) {
-        if (pointInPolygon(p, contour)) {
-            return !contour.isHole;
+        int w = windingNumber(p, contour);
+        winding += w;
+        // Число пересечений имеет ту же чётность, что и число оборотов
+        if (w % 2 != 0) inside = !inside;
+    }
+    return rule == NON_ZERO ? winding != 0 : inside;
+}
+
+void PolygonBoolean::sweepCrossings(const std::vector<BoolPoint>& points,
+                                    const std::vector<PolygonContour>& polygons,
+                                    const std::vector<int>* skipContour,
+                                    std::vector<int>& crossings, std::vector<int>& winding) {
+    crossings.assign(points.size(), 0);
+    winding.assign(points.size(), 0);
+
+    std::vector<SweepEdge> edges;
+    for (size_t c = 0; c < polygons.size(); c++) {
+        const auto& contour = polygons[c].points;
+        if (contour.size() < 3) continue;
+
+        for (size_t i = 0, j = contour.size() - 1; i < contour.size(); j = i++) {
+            const BoolPoint& from = contour[j];
+            const BoolPoint& to = contour[i];
+            if (from.y == to.y) continue;
+
+            SweepEdge e;
+            e.yLow = std::min(from.y, to.y);
+            e.yHigh = std::max(from.y, to.y);
+            e.from = from;
+            e.to = to;
+            e.contour = static_cast<int>(c);
+            e.direction = to.y > from.y ? 1 : -1;
+            edges.push_back(e);
         }
     }
-    return false;
+    std::sort(edges.begin(), edges.end(),
+              [](const SweepEdge& a, const SweepEdge& b) { return a.yLow < b.yLow; });
+
+    std::vector<size_t> order(points.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&points](size_t a, size_t b) { return points[a].y < points[b].y; });
+
+    // Активны рёбра с yLow <= y < yHigh — ровно те, что пересекает горизонтальный луч
+    std::vector<const SweepEdge*> active;
+    size_t nextEdge = 0;
+    for (size_t q : order) {
+        const BoolPoint& p = points[q];
+        while (nextEdge < edges.size() && edges[nextEdge].yLow <= p.y) {
+            active.push_back(&edges[nextEdge++]);
+        }
+
+        int skip = skipContour ? (*skipContour)[q] : -1;
+        size_t kept = 0;
+        for (size_t k = 0; k < active.size(); k++) {
+            const SweepEdge* e = active[k];
+            if (e->yHigh <= p.y) continue;
+            active[kept++] = e;
+
+            if (e->contour != skip && rayCrossesEdge(p, e->from, e->to)) {
+                crossings[q]++;
+                winding[q] += e->direction;
+            }
+        }
+        active.resize(kept);
+    }
+}
+
+std::vector<char> PolygonBoolean::classifyPoints(const std::vector<BoolPoint>& points,
+                                                 const std::vector<PolygonContour>& polygons,
+                                                 FillRule rule) {
+    std::vector<int> crossings, winding;
+    sweepCrossings(points, polygons, nullptr, crossings, winding);
+
+    std::vector<char> inside(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        inside[i] = rule == NON_ZERO ? winding[i] != 0 : crossings[i] % 2 != 0;
+    }
+    return inside;
+}
+
+void PolygonBoolean::classifyHoles(std::vector<PolygonContour>& contours) {
+    std::vector<BoolPoint> probes;
+    std::vector<int> owners;
+    std::vector<size_t> probeOf(contours.size(), 0);
+    for (size_t c = 0; c < contours.size(); c++) {
+        contours[c].isHole = false;
+        if (contours[c].points.empty()) continue;
+        probeOf[c] = probes.size();
+        probes.push_back(contours[c].points[0]);
+        owners.push_back(static_cast<int>(c));
+    }
+
+    std::vector<int> crossings, winding;
+    sweepCrossings(probes, contours, &owners, crossings, winding);
+    for (size_t c = 0; c < contours.size(); c++) {
+        if (!contours[c].points.empty()) contours[c].isHole = crossings[probeOf[c]] % 2 != 0;
+    }
 }
 
 bool PolygonBoolean::segmentsIntersect(const BoolPoint& a1, const BoolPoint& a2,
@@ -70,6 +182,32 @@ void PolygonBoolean::ensureWindingOrder(PolygonContour& contour, bool clockwise)
     }
 }
 
+bool PolygonBoolean::buildContour(std::vector<BoolPoint>& points, PolygonContour& contour) {
+    if (points.size() < 3) return false;
+
+    if (points.size() > 3) {
+        BoolPoint center(0, 0);
+        for (const auto& p : points) {
+            center.x += p.x;
+            center.y += p.y;
+        }
+        center.x /= points.size();
+        center.y /= points.size();
+
+        std::sort(points.begin(), points.end(),
+                  [center](const BoolPoint& a, const BoolPoint& b) {
+                      double angleA = std::atan2(a.y - center.y, a.x - center.x);
+                      double angleB = std::atan2(b.y - center.y, b.x - center.x);
+                      return angleA < angleB;
+                  });
+    }
+
+    contour.points = points;
+    contour.isHole = false;
+    ensureWindingOrder(contour, false);
+    return true;
+}
+
 std::vector<PolygonContour> PolygonBoolean::booleanOperation(
     const std::vector<PolygonContour>& poly1,
     const std::vector<PolygonContour>& poly2,
@@ -100,23 +238,17 @@ std::vector<PolygonContour> PolygonBoolean::booleanOperation(
                 if (contour2.points.size() < 3) continue;
 
                 std::vector<BoolPoint> allPoints;
-                std::set<BoolPoint> uniquePoints;
+                PointHashGrid<BoolPoint> uniquePoints(1e-9, contour1.points.size() + contour2.points.size());
 
                 for (const auto& p : contour1.points) {
-                    if (pointInPolygon(p, contour2)) {
-                        if (uniquePoints.find(p) == uniquePoints.end()) {
-                            allPoints.push_back(p);
-                            uniquePoints.insert(p);
-                        }
+                    if (pointInPolygon(p, contour2) && uniquePoints.insert(p)) {
+                        allPoints.push_back(p);
                     }
                 }
 
                 for (const auto& p : contour2.points) {
-                    if (pointInPolygon(p, contour1)) {
-                        if (uniquePoints.find(p) == uniquePoints.end()) {
-                            allPoints.push_back(p);
-                            uniquePoints.insert(p);
-                        }
+                    if (pointInPolygon(p, contour1) && uniquePoints.insert(p)) {
+                        allPoints.push_back(p);
                     }
                 }
 
@@ -131,37 +263,14 @@ std::vector<PolygonContour> PolygonBoolean::booleanOperation(
                         const BoolPoint& b2 = contour2.points[next_j];
 
                         BoolPoint intersect;
-                        if (segmentsIntersect(a1, a2, b1, b2, intersect)) {
-                            if (uniquePoints.find(intersect) == uniquePoints.end()) {
-                                allPoints.push_back(intersect);
-                                uniquePoints.insert(intersect);
-                            }
+                        if (segmentsIntersect(a1, a2, b1, b2, intersect) && uniquePoints.insert(intersect)) {
+                            allPoints.push_back(intersect);
                         }
                     }
                 }
 
-                if (allPoints.size() >= 3) {
-                    if (allPoints.size() > 3) {
-                        BoolPoint center(0, 0);
-                        for (const auto& p : allPoints) {
-                            center.x += p.x;
-                            center.y += p.y;
-                        }
-                        center.x /= allPoints.size();
-                        center.y /= allPoints.size();
-
-                        std::sort(allPoints.begin(), allPoints.end(),
-                                  [center](const BoolPoint& a, const BoolPoint& b) {
-                                      double angleA = std::atan2(a.y - center.y, a.x - center.x);
-                                      double angleB = std::atan2(b.y - center.y, b.x - center.x);
-                                      return angleA < angleB;
-                                  });
-                    }
-
-                    PolygonContour newContour;
-                    newContour.points = allPoints;
-                    newContour.isHole = false;
-                    ensureWindingOrder(newContour, false);
+                PolygonContour newContour;
+                if (buildContour(allPoints, newContour)) {
                     result.push_back(newContour);
                 }
             }
@@ -173,23 +282,25 @@ std::vector<PolygonContour> PolygonBoolean::booleanOperation(
         if (poly1.empty()) return result;
         if (poly2.empty()) return poly1;
 
+        std::vector<BoolPoint> vertices1;
         for (const auto& contour1 : poly1) {
+            vertices1.insert(vertices1.end(), contour1.points.begin(), contour1.points.end());
+        }
+        std::vector<char> insideSecond = classifyPoints(vertices1, poly2, EVEN_ODD);
+
+        size_t offset = 0;
+        for (const auto& contour1 : poly1) {
+            size_t first = offset;
+            offset += contour1.points.size();
             if (contour1.points.size() < 3) continue;
 
             std::vector<BoolPoint> allPoints;
-            std::set<BoolPoint> uniquePoints;
+            PointHashGrid<BoolPoint> uniquePoints(1e-9, contour1.points.size() * 2);
 
-            for (const auto& p : contour1.points) {
-                bool insideAny = false;
-                for (const auto& contour2 : poly2) {
-                    if (pointInPolygon(p, contour2)) {
-                        insideAny = true;
-                        break;
-                    }
-                }
-                if (!insideAny && uniquePoints.find(p) == uniquePoints.end()) {
+            for (size_t i = 0; i < contour1.points.size(); i++) {
+                const BoolPoint& p = contour1.points[i];
+                if (!insideSecond[first + i] && uniquePoints.insert(p)) {
                     allPoints.push_back(p);
-                    uniquePoints.insert(p);
                 }
             }
 
@@ -207,38 +318,296 @@ std::vector<PolygonContour> PolygonBoolean::booleanOperation(
                         const BoolPoint& b2 = contour2.points[next_j];
 
                         BoolPoint intersect;
-                        if (segmentsIntersect(a1, a2, b1, b2, intersect)) {
-                            if (uniquePoints.find(intersect) == uniquePoints.end()) {
-                                allPoints.push_back(intersect);
-                                uniquePoints.insert(intersect);
-                            }
+                        if (segmentsIntersect(a1, a2, b1, b2, intersect) && uniquePoints.insert(intersect)) {
+                            allPoints.push_back(intersect);
                         }
                     }
                 }
             }
 
-            if (allPoints.size() >= 3) {
-                if (allPoints.size() > 3) {
-                    BoolPoint center(0, 0);
-                    for (const auto& p : allPoints) {
-                        center.x += p.x;
-                        center.y += p.y;
+            PolygonContour newContour;
+            if (buildContour(allPoints, newContour)) {
+                result.push_back(newContour);
+            }
+        }
+        return result;
+    }
+
+    return result;
+}
+
+// a * b / den с округлением половин от нуля, den > 0. Без __int128 произведение
+// модулей собирается из 32-битных половин в два 64-битных слова и делится
+// столбиком по битам: результат тот же на любой платформе.
+static long long roundedProductQuotient(long long a, long long b, long long den) {
+#ifdef __SIZEOF_INT128__
+    __int128 num = static_cast<__int128>(a) * b;
+    __int128 q = num / den;
+    __int128 r = num % den;
+    if (r < 0) r = -r;
+    if (2 * r >= den) q += num < 0 ? -1 : 1;
+    return static_cast<long long>(q);
+#else
+    bool negative = (a < 0) != (b < 0);
+    unsigned long long ua = a < 0 ? 0 - static_cast<unsigned long long>(a) : static_cast<unsigned long long>(a);
+    unsigned long long ub = b < 0 ? 0 - static_cast<unsigned long long>(b) : static_cast<unsigned long long>(b);
+
+    const unsigned long long mask = 0xffffffffULL;
+    unsigned long long low = (ua & mask) * (ub & mask);
+    unsigned long long high = (ua >> 32) * (ub >> 32);
+    unsigned long long cross1 = (ua >> 32) * (ub & mask);
+    unsigned long long cross2 = (ua & mask) * (ub >> 32);
+    unsigned long long cross = cross1 + cross2;
+    if (cross < cross1) high += 1ULL << 32;
+    high += cross >> 32;
+    unsigned long long crossLow = cross << 32;
+    low += crossLow;
+    if (low < crossLow) high++;
+
+    // Остаток меньше den < 2^63, поэтому сдвиг остатка не переполняется
+    unsigned long long d = static_cast<unsigned long long>(den);
+    unsigned long long q = 0, r = 0;
+    for (int bit = 127; bit >= 0; bit--) {
+        unsigned long long next = bit >= 64 ? (high >> (bit - 64)) & 1 : (low >> bit) & 1;
+        r = (r << 1) | next;
+        q <<= 1;
+        if (r >= d) {
+            r -= d;
+            q |= 1;
+        }
+    }
+    if (2 * r >= d) q++;
+    return negative ? -static_cast<long long>(q) : static_cast<long long>(q);
+#endif
+}
+
+std::vector<GridContour> PolygonBoolean::snapContours(const std::vector<PolygonContour>& contours,
+                                                      double gridSize, bool& inRange) {
+    std::vector<GridContour> result(contours.size());
+
+    for (size_t c = 0; c < contours.size(); c++) {
+        auto& points = result[c].points;
+        for (const auto& p : contours[c].points) {
+            double gx = std::round(p.x / gridSize);
+            double gy = std::round(p.y / gridSize);
+            if (!(std::abs(gx) <= kMaxGridCoordinate && std::abs(gy) <= kMaxGridCoordinate)) {
+                inRange = false;
+                return {};
+            }
+
+            GridPoint g(static_cast<long long>(gx), static_cast<long long>(gy));
+            if (points.empty() || points.back() != g) points.push_back(g);
+        }
+        while (points.size() > 1 && points.back() == points.front()) points.pop_back();
+    }
+    return result;
+}
+
+bool PolygonBoolean::rayCrossesEdgeExact(const GridPoint& p, const GridPoint& from, const GridPoint& to) {
+    if ((to.y > p.y) == (from.y > p.y)) return false;
+
+    long long dy = from.y - to.y;
+    long long lhs = (p.x - to.x) * dy;
+    long long rhs = (from.x - to.x) * (p.y - to.y);
+    return dy > 0 ? lhs < rhs : lhs > rhs;
+}
+
+bool PolygonBoolean::pointInPolygonExact(const GridPoint& p, const GridContour& contour) {
+    if (contour.points.size() < 3) return false;
+
+    bool inside = false;
+    for (size_t i = 0, j = contour.points.size() - 1; i < contour.points.size(); j = i++) {
+        if (rayCrossesEdgeExact(p, contour.points[j], contour.points[i])) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+bool PolygonBoolean::segmentsIntersectExact(const GridPoint& a1, const GridPoint& a2,
+                                            const GridPoint& b1, const GridPoint& b2,
+                                            GridPoint& intersect) {
+    long long d1x = a2.x - a1.x, d1y = a2.y - a1.y;
+    long long d2x = b2.x - b1.x, d2y = b2.y - b1.y;
+    long long ex = b1.x - a1.x, ey = b1.y - a1.y;
+
+    long long den = d1x * d2y - d1y * d2x;
+    if (den == 0) return false;
+
+    long long tn = ex * d2y - ey * d2x;
+    long long un = ex * d1y - ey * d1x;
+    if (den < 0) {
+        den = -den;
+        tn = -tn;
+        un = -un;
+    }
+
+    if (tn < 0 || tn > den || un < 0 || un > den) return false;
+
+    intersect.x = a1.x + roundedProductQuotient(d1x, tn, den);
+    intersect.y = a1.y + roundedProductQuotient(d1y, tn, den);
+    return true;
+}
+
+bool PolygonBoolean::buildContourExact(std::vector<GridPoint>& points, double gridSize,
+                                       PolygonContour& contour) {
+    if (points.size() < 3) return false;
+
+    long long sumX = 0, sumY = 0;
+    for (const auto& p : points) {
+        sumX += p.x;
+        sumY += p.y;
+    }
+    long long count = static_cast<long long>(points.size());
+    GridPoint center(roundedProductQuotient(sumX, 1, count), roundedProductQuotient(sumY, 1, count));
+
+    std::sort(points.begin(), points.end(), [center](const GridPoint& pa, const GridPoint& pb) {
+        GridPoint a(pa.x - center.x, pa.y - center.y);
+        GridPoint b(pb.x - center.x, pb.y - center.y);
+
+        int halfA = a.y < 0 ? 0 : 1;
+        int halfB = b.y < 0 ? 0 : 1;
+        if (halfA != halfB) return halfA < halfB;
+
+        bool zeroA = a.x == 0 && a.y == 0;
+        bool zeroB = b.x == 0 && b.y == 0;
+        if (zeroA || zeroB) return zeroA && !zeroB;
+
+        long long cross = a.x * b.y - a.y * b.x;
+        if (cross != 0) return cross > 0;
+        if (a.x * b.x + a.y * b.y < 0) return a.x > b.x;
+        return a.x * a.x + a.y * a.y < b.x * b.x + b.y * b.y;
+    });
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 3) return false;
+
+    contour.points.clear();
+    for (const auto& p : points) {
+        contour.points.push_back(BoolPoint(p.x * gridSize, p.y * gridSize));
+    }
+    contour.isHole = false;
+    ensureWindingOrder(contour, false);
+    return true;
+}
+
+std::vector<PolygonContour> PolygonBoolean::booleanOperationSnapped(
+    const std::vector<PolygonContour>& poly1,
+    const std::vector<PolygonContour>& poly2,
+    Operation op,
+    double gridSize) {
+
+    std::vector<PolygonContour> result;
+
+    if (poly1.empty() && poly2.empty()) return result;
+    if (!(gridSize > 0)) return booleanOperation(poly1, poly2, op);
+
+    bool inRange = true;
+    std::vector<GridContour> grid1 = snapContours(poly1, gridSize, inRange);
+    std::vector<GridContour> grid2 = snapContours(poly2, gridSize, inRange);
+    if (!inRange) return booleanOperation(poly1, poly2, op);
+
+    auto toContour = [gridSize](const GridContour& g) {
+        PolygonContour contour;
+        for (const auto& p : g.points) {
+            contour.points.push_back(BoolPoint(p.x * gridSize, p.y * gridSize));
+        }
+        return contour;
+    };
+
+    if (op == UNION) {
+        for (const auto& g : grid1) result.push_back(toContour(g));
+        for (const auto& g : grid2) result.push_back(toContour(g));
+
+        for (auto& contour : result) {
+            ensureWindingOrder(contour, false);
+            contour.isHole = false;
+        }
+        return result;
+    }
+
+    if (op == INTERSECTION) {
+        if (grid1.empty() || grid2.empty()) return result;
+
+        for (const auto& contour1 : grid1) {
+            if (contour1.points.size() < 3) continue;
+
+            for (const auto& contour2 : grid2) {
+                if (contour2.points.size() < 3) continue;
+
+                std::vector<GridPoint> allPoints;
+
+                for (const auto& p : contour1.points) {
+                    if (pointInPolygonExact(p, contour2)) allPoints.push_back(p);
+                }
+
+                for (const auto& p : contour2.points) {
+                    if (pointInPolygonExact(p, contour1)) allPoints.push_back(p);
+                }
+
+                for (size_t i = 0; i < contour1.points.size(); i++) {
+                    size_t next_i = (i + 1) % contour1.points.size();
+                    for (size_t j = 0; j < contour2.points.size(); j++) {
+                        size_t next_j = (j + 1) % contour2.points.size();
+
+                        GridPoint intersect;
+                        if (segmentsIntersectExact(contour1.points[i], contour1.points[next_i],
+                                                   contour2.points[j], contour2.points[next_j],
+                                                   intersect)) {
+                            allPoints.push_back(intersect);
+                        }
                     }
-                    center.x /= allPoints.size();
-                    center.y /= allPoints.size();
-
-                    std::sort(allPoints.begin(), allPoints.end(),
-                              [center](const BoolPoint& a, const BoolPoint& b) {
-                                  double angleA = std::atan2(a.y - center.y, a.x - center.x);
-                                  double angleB = std::atan2(b.y - center.y, b.x - center.x);
-                                  return angleA < angleB;
-                              });
                 }
 
                 PolygonContour newContour;
-                newContour.points = allPoints;
-                newContour.isHole = false;
-                ensureWindingOrder(newContour, false);
+                if (buildContourExact(allPoints, gridSize, newContour)) {
+                    result.push_back(newContour);
+                }
+            }
+        }
+        return result;
+    }
+
+    if (op == DIFFERENCE) {
+        if (grid1.empty()) return result;
+        if (grid2.empty()) {
+            for (const auto& g : grid1) result.push_back(toContour(g));
+            return result;
+        }
+
+        for (const auto& contour1 : grid1) {
+            if (contour1.points.size() < 3) continue;
+
+            std::vector<GridPoint> allPoints;
+
+            for (const auto& p : contour1.points) {
+                // Чётно-нечётное правило, как и в booleanOperation
+                bool inside = false;
+                for (const auto& contour2 : grid2) {
+                    if (pointInPolygonExact(p, contour2)) inside = !inside;
+                }
+                if (!inside) allPoints.push_back(p);
+            }
+
+            for (const auto& contour2 : grid2) {
+                if (contour2.points.size() < 3) continue;
+
+                for (size_t i = 0; i < contour1.points.size(); i++) {
+                    size_t next_i = (i + 1) % contour1.points.size();
+                    for (size_t j = 0; j < contour2.points.size(); j++) {
+                        size_t next_j = (j + 1) % contour2.points.size();
+
+                        GridPoint intersect;
+                        if (segmentsIntersectExact(contour1.points[i], contour1.points[next_i],
+                                                   contour2.points[j], contour2.points[next_j],
+                                                   intersect)) {
+                            allPoints.push_back(intersect);
+                        }
+                    }
+                }
+            }
+
+            PolygonContour newContour;
+            if (buildContourExact(allPoints, gridSize, newContour)) {
                 result.push_back(newContour);
             }
         }
@@ -247,3 +616,357 @@ std::vector<PolygonContour> PolygonBoolean::booleanOperation(
 
     return result;
 }
+
+IncrementalPolygonBoolean::IncrementalPolygonBoolean()
+    : operation(PolygonBoolean::UNION), resultDirty(true) {}
+
+void IncrementalPolygonBoolean::setInput(const std::vector<PolygonContour>& first,
+                                         const std::vector<PolygonContour>& second,
+                                         PolygonBoolean::Operation op) {
+    poly1 = first;
+    poly2 = second;
+
+    pairs.assign(poly1.size() * poly2.size(), PairState());
+    for (size_t c1 = 0; c1 < poly1.size(); c1++) {
+        for (size_t c2 = 0; c2 < poly2.size(); c2++) {
+            rebuildPair(c1, c2);
+        }
+    }
+
+    setOperation(op);
+}
+
+void IncrementalPolygonBoolean::setOperation(PolygonBoolean::Operation op) {
+    operation = op;
+
+    size_t slots = 0;
+    if (op == PolygonBoolean::INTERSECTION) slots = poly1.size() * poly2.size();
+    else if (op == PolygonBoolean::DIFFERENCE) slots = poly1.size();
+
+    slotContours.assign(slots, PolygonContour());
+    slotValid.assign(slots, 0);
+    resultDirty = true;
+}
+
+void IncrementalPolygonBoolean::rebuildPair(size_t c1, size_t c2) {
+    PairState& state = pairAt(c1, c2);
+    state = PairState();
+
+    const auto& a = poly1[c1].points;
+    const auto& b = poly2[c2].points;
+    if (a.size() < 3 || b.size() < 3) return;
+
+    state.inside1.resize(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        state.inside1[i] = PolygonBoolean::pointInPolygon(a[i], poly2[c2]);
+    }
+
+    state.inside2.resize(b.size());
+    for (size_t j = 0; j < b.size(); j++) {
+        state.inside2[j] = PolygonBoolean::pointInPolygon(b[j], poly1[c1]);
+    }
+
+    for (size_t i = 0; i < a.size(); i++) {
+        size_t next_i = (i + 1) % a.size();
+        for (size_t j = 0; j < b.size(); j++) {
+            size_t next_j = (j + 1) % b.size();
+            BoolPoint intersect;
+            if (PolygonBoolean::segmentsIntersect(a[i], a[next_i], b[j], b[next_j], intersect)) {
+                state.crossings.emplace_back(i, j, intersect);
+            }
+        }
+    }
+}
+
+void IncrementalPolygonBoolean::rebuildContourPairs(Input input, size_t contour) {
+    if (input == FIRST) {
+        for (size_t c2 = 0; c2 < poly2.size(); c2++) rebuildPair(contour, c2);
+    } else {
+        for (size_t c1 = 0; c1 < poly1.size(); c1++) rebuildPair(c1, contour);
+    }
+    markDirty(input, contour);
+}
+
+void IncrementalPolygonBoolean::markDirty(Input input, size_t contour) {
+    resultDirty = true;
+
+    if (operation == PolygonBoolean::INTERSECTION) {
+        if (input == FIRST) {
+            for (size_t c2 = 0; c2 < poly2.size(); c2++) slotValid[contour * poly2.size() + c2] = 0;
+        } else {
+            for (size_t c1 = 0; c1 < poly1.size(); c1++) slotValid[c1 * poly2.size() + contour] = 0;
+        }
+    } else if (operation == PolygonBoolean::DIFFERENCE) {
+        if (input == FIRST) {
+            slotValid[contour] = 0;
+        } else {
+            std::fill(slotValid.begin(), slotValid.end(), 0);
+        }
+    }
+}
+
+void IncrementalPolygonBoolean::moveVertex(Input input, size_t contour, size_t index, const BoolPoint& p) {
+    auto& points = contoursOf(input)[contour].points;
+    size_t n = points.size();
+    if (index >= n) return;
+
+    if (n < 3) {
+        points[index] = p;
+        rebuildContourPairs(input, contour);
+        return;
+    }
+
+    VertexEdit edit;
+    edit.kind = EDIT_MOVE;
+    edit.vertex = index;
+    edit.removedEdges = { (index + n - 1) % n, index };
+    for (size_t e : edit.removedEdges) {
+        edit.removedFrom.push_back(points[e]);
+        edit.removedTo.push_back(points[(e + 1) % n]);
+    }
+
+    points[index] = p;
+    edit.addedEdges = edit.removedEdges;
+    applyEdit(input, contour, edit);
+}
+
+void IncrementalPolygonBoolean::insertVertex(Input input, size_t contour, size_t index, const BoolPoint& p) {
+    auto& points = contoursOf(input)[contour].points;
+    size_t n = points.size();
+    if (index > n) return;
+
+    if (n < 3) {
+        points.insert(points.begin() + index, p);
+        rebuildContourPairs(input, contour);
+        return;
+    }
+
+    VertexEdit edit;
+    edit.kind = EDIT_INSERT;
+    edit.vertex = index;
+    size_t removed = (index + n - 1) % n;
+    edit.removedEdges = { removed };
+    edit.removedFrom.push_back(points[removed]);
+    edit.removedTo.push_back(points[(removed + 1) % n]);
+
+    points.insert(points.begin() + index, p);
+    size_t m = n + 1;
+    edit.addedEdges = { (index + m - 1) % m, index };
+    applyEdit(input, contour, edit);
+}
+
+void IncrementalPolygonBoolean::eraseVertex(Input input, size_t contour, size_t index) {
+    auto& points = contoursOf(input)[contour].points;
+    size_t n = points.size();
+    if (index >= n) return;
+
+    if (n <= 3) {
+        points.erase(points.begin() + index);
+        rebuildContourPairs(input, contour);
+        return;
+    }
+
+    VertexEdit edit;
+    edit.kind = EDIT_ERASE;
+    edit.vertex = index;
+    edit.removedEdges = { (index + n - 1) % n, index };
+    for (size_t e : edit.removedEdges) {
+        edit.removedFrom.push_back(points[e]);
+        edit.removedTo.push_back(points[(e + 1) % n]);
+    }
+
+    points.erase(points.begin() + index);
+    size_t m = n - 1;
+    edit.addedEdges = { (index + m - 1) % m };
+    applyEdit(input, contour, edit);
+}
+
+void IncrementalPolygonBoolean::applyEdit(Input input, size_t contour, const VertexEdit& edit) {
+    size_t others = input == FIRST ? poly2.size() : poly1.size();
+    for (size_t other = 0; other < others; other++) {
+        updatePair(input, contour, other, edit);
+    }
+    markDirty(input, contour);
+}
+
+void IncrementalPolygonBoolean::updatePair(Input input, size_t contour, size_t other, const VertexEdit& edit) {
+    size_t c1 = input == FIRST ? contour : other;
+    size_t c2 = input == FIRST ? other : contour;
+    PairState& state = pairAt(c1, c2);
+
+    const PolygonContour& edited = input == FIRST ? poly1[c1] : poly2[c2];
+    const PolygonContour& fixed = input == FIRST ? poly2[c2] : poly1[c1];
+    if (fixed.points.size() < 3) return;
+
+    const auto& e = edited.points;
+    const auto& f = fixed.points;
+    std::vector<char>& ownInside = input == FIRST ? state.inside1 : state.inside2;
+    std::vector<char>& otherInside = input == FIRST ? state.inside2 : state.inside1;
+
+    auto edgeOf = [input](Crossing& c) -> size_t& { return input == FIRST ? c.edge1 : c.edge2; };
+
+    state.crossings.erase(
+        std::remove_if(state.crossings.begin(), state.crossings.end(), [&](Crossing& c) {
+            return std::find(edit.removedEdges.begin(), edit.removedEdges.end(), edgeOf(c)) !=
+                   edit.removedEdges.end();
+        }),
+        state.crossings.end());
+
+    if (edit.kind == EDIT_INSERT) {
+        for (auto& c : state.crossings) {
+            if (edgeOf(c) >= edit.vertex) edgeOf(c)++;
+        }
+    } else if (edit.kind == EDIT_ERASE) {
+        for (auto& c : state.crossings) {
+            if (edgeOf(c) > edit.vertex) edgeOf(c)--;
+        }
+    }
+
+    double minY = std::numeric_limits<double>::max();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (size_t r = 0; r < edit.removedEdges.size(); r++) {
+        minY = std::min({ minY, edit.removedFrom[r].y, edit.removedTo[r].y });
+        maxY = std::max({ maxY, edit.removedFrom[r].y, edit.removedTo[r].y });
+    }
+    for (size_t a : edit.addedEdges) {
+        minY = std::min({ minY, e[a].y, e[(a + 1) % e.size()].y });
+        maxY = std::max({ maxY, e[a].y, e[(a + 1) % e.size()].y });
+    }
+
+    for (size_t j = 0; j < f.size(); j++) {
+        const BoolPoint& q = f[j];
+        if (q.y < minY || q.y > maxY) continue;
+
+        bool flip = false;
+        for (size_t r = 0; r < edit.removedEdges.size(); r++) {
+            if (PolygonBoolean::rayCrossesEdge(q, edit.removedFrom[r], edit.removedTo[r])) flip = !flip;
+        }
+        for (size_t a : edit.addedEdges) {
+            if (PolygonBoolean::rayCrossesEdge(q, e[a], e[(a + 1) % e.size()])) flip = !flip;
+        }
+        if (flip) otherInside[j] = !otherInside[j];
+    }
+
+    switch (edit.kind) {
+    case EDIT_MOVE:
+        ownInside[edit.vertex] = PolygonBoolean::pointInPolygon(e[edit.vertex], fixed);
+        break;
+    case EDIT_INSERT:
+        ownInside.insert(ownInside.begin() + edit.vertex,
+                         PolygonBoolean::pointInPolygon(e[edit.vertex], fixed));
+        break;
+    case EDIT_ERASE:
+        ownInside.erase(ownInside.begin() + edit.vertex);
+        break;
+    }
+
+    for (size_t a : edit.addedEdges) {
+        const BoolPoint& a1 = e[a];
+        const BoolPoint& a2 = e[(a + 1) % e.size()];
+        double loX = std::min(a1.x, a2.x), hiX = std::max(a1.x, a2.x);
+
+        for (size_t j = 0; j < f.size(); j++) {
+            const BoolPoint& b1 = f[j];
+            const BoolPoint& b2 = f[(j + 1) % f.size()];
+            if (std::max(b1.x, b2.x) < loX || std::min(b1.x, b2.x) > hiX) continue;
+
+            BoolPoint intersect;
+            if (input == FIRST) {
+                if (PolygonBoolean::segmentsIntersect(a1, a2, b1, b2, intersect)) {
+                    state.crossings.emplace_back(a, j, intersect);
+                }
+            } else {
+                if (PolygonBoolean::segmentsIntersect(b1, b2, a1, a2, intersect)) {
+                    state.crossings.emplace_back(j, a, intersect);
+                }
+            }
+        }
+    }
+}
+
+void IncrementalPolygonBoolean::buildSlot(size_t slot) {
+    std::vector<BoolPoint> allPoints;
+    PointHashGrid<BoolPoint> uniquePoints;
+    auto addPoint = [&](const BoolPoint& p) {
+        if (uniquePoints.insert(p)) allPoints.push_back(p);
+    };
+    auto crossingOrder = [](const Crossing& a, const Crossing& b) {
+        return a.edge1 != b.edge1 ? a.edge1 < b.edge1 : a.edge2 < b.edge2;
+    };
+
+    if (operation == PolygonBoolean::INTERSECTION) {
+        size_t c1 = slot / poly2.size();
+        size_t c2 = slot % poly2.size();
+        const auto& a = poly1[c1].points;
+        const auto& b = poly2[c2].points;
+
+        if (a.size() >= 3 && b.size() >= 3) {
+            PairState& state = pairAt(c1, c2);
+            for (size_t i = 0; i < a.size(); i++) {
+                if (state.inside1[i]) addPoint(a[i]);
+            }
+            for (size_t j = 0; j < b.size(); j++) {
+                if (state.inside2[j]) addPoint(b[j]);
+            }
+            std::sort(state.crossings.begin(), state.crossings.end(), crossingOrder);
+            for (const auto& c : state.crossings) addPoint(c.point);
+        }
+    } else if (operation == PolygonBoolean::DIFFERENCE) {
+        size_t c1 = slot;
+        const auto& a = poly1[c1].points;
+
+        if (a.size() >= 3) {
+            for (size_t i = 0; i < a.size(); i++) {
+                bool inside = false;
+                for (size_t c2 = 0; c2 < poly2.size(); c2++) {
+                    if (poly2[c2].points.size() >= 3 && pairAt(c1, c2).inside1[i]) inside = !inside;
+                }
+                if (!inside) addPoint(a[i]);
+            }
+            for (size_t c2 = 0; c2 < poly2.size(); c2++) {
+                if (poly2[c2].points.size() < 3) continue;
+                PairState& state = pairAt(c1, c2);
+                std::sort(state.crossings.begin(), state.crossings.end(), crossingOrder);
+                for (const auto& c : state.crossings) addPoint(c.point);
+            }
+        }
+    }
+
+    slotContours[slot] = PolygonContour();
+    PolygonBoolean::buildContour(allPoints, slotContours[slot]);
+    slotValid[slot] = 1;
+}
+
+const std::vector<PolygonContour>& IncrementalPolygonBoolean::result() {
+    if (!resultDirty) return resultContours;
+
+    resultContours.clear();
+    resultDirty = false;
+
+    if (poly1.empty() && poly2.empty()) return resultContours;
+
+    if (operation == PolygonBoolean::UNION) {
+        resultContours = poly1;
+        resultContours.insert(resultContours.end(), poly2.begin(), poly2.end());
+        for (auto& contour : resultContours) {
+            PolygonBoolean::ensureWindingOrder(contour, false);
+            contour.isHole = false;
+        }
+        return resultContours;
+    }
+
+    if (operation == PolygonBoolean::INTERSECTION && (poly1.empty() || poly2.empty())) return resultContours;
+    if (operation == PolygonBoolean::DIFFERENCE) {
+        if (poly1.empty()) return resultContours;
+        if (poly2.empty()) {
+            resultContours = poly1;
+            return resultContours;
+        }
+    }
+
+    for (size_t slot = 0; slot < slotContours.size(); slot++) {
+        if (!slotValid[slot]) buildSlot(slot);
+        if (!slotContours[slot].points.empty()) resultContours.push_back(slotContours[slot]);
+    }
+    return resultContours;
+}
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cmath>
+#include <cstddef>
 
 struct BoolPoint {
     double x, y;
@@ -34,6 +35,21 @@ struct BoolPoint {
     }
 };
 
+struct GridPoint {
+    long long x, y;
+    GridPoint(long long x = 0, long long y = 0) : x(x), y(y) {}
+
+    bool operator==(const GridPoint& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const GridPoint& other) const { return !(*this == other); }
+    bool operator<(const GridPoint& other) const {
+        return x != other.x ? x < other.x : y < other.y;
+    }
+};
+
+struct GridContour {
+    std::vector<GridPoint> points;
+};
+
 struct PolygonContour {
     std::vector<BoolPoint> points;
     bool isHole;
@@ -44,20 +60,139 @@ struct PolygonContour {
 class PolygonBoolean {
 public:
     enum Operation { INTERSECTION, UNION, DIFFERENCE };
+    enum FillRule { EVEN_ODD, NON_ZERO };
     
     static std::vector<PolygonContour> booleanOperation(
         const std::vector<PolygonContour>& poly1,
         const std::vector<PolygonContour>& poly2,
         Operation op);
+
+    // Режим привязки к целочисленной сетке с шагом gridSize: вершины
+    // округляются к узлам сетки, все предикаты считаются точно в int64,
+    // точки пересечения тоже округляются к узлам. Если координаты после
+    // привязки не укладываются в kMaxGridCoordinate, используется обычный
+    // booleanOperation.
+    static std::vector<PolygonContour> booleanOperationSnapped(
+        const std::vector<PolygonContour>& poly1,
+        const std::vector<PolygonContour>& poly2,
+        Operation op,
+        double gridSize);
+
+    static constexpr long long kMaxGridCoordinate = 1LL << 29;
+
+    // Число оборотов контура вокруг точки: +1 за каждый обход против часовой стрелки
+    static int windingNumber(const BoolPoint& p, const PolygonContour& contour);
+
+    // Принадлежность точки области, заданной всеми контурами сразу. Флаг isHole
+    // не учитывается: вложенность и самопересечения разрешает правило заливки.
+    static bool pointInPolygonList(const BoolPoint& p, const std::vector<PolygonContour>& polygons,
+                                   FillRule rule = EVEN_ODD);
+
+    // Пакетный вариант: все точки классифицируются одним проходом заметающей
+    // прямой по рёбрам всех контуров
+    static std::vector<char> classifyPoints(const std::vector<BoolPoint>& points,
+                                            const std::vector<PolygonContour>& polygons,
+                                            FillRule rule = EVEN_ODD);
+
+    // Выставляет isHole по чётности глубины вложенности каждого контура
+    static void classifyHoles(std::vector<PolygonContour>& contours);
     
 private:
+    friend class IncrementalPolygonBoolean;
+
+    struct SweepEdge {
+        double yLow, yHigh;
+        BoolPoint from, to;
+        int contour;
+        int direction;
+    };
+
+    static bool rayCrossesEdge(const BoolPoint& p, const BoolPoint& from, const BoolPoint& to);
     static bool pointInPolygon(const BoolPoint& p, const PolygonContour& contour);
-    static bool pointInPolygonList(const BoolPoint& p, const std::vector<PolygonContour>& polygons);
+    // Для каждой точки считает число пересечений луча вправо и число оборотов;
+    // рёбра контура skipContour[i] для точки i не учитываются
+    static void sweepCrossings(const std::vector<BoolPoint>& points,
+                               const std::vector<PolygonContour>& polygons,
+                               const std::vector<int>* skipContour,
+                               std::vector<int>& crossings, std::vector<int>& winding);
     static bool segmentsIntersect(const BoolPoint& a1, const BoolPoint& a2,
                                   const BoolPoint& b1, const BoolPoint& b2,
                                   BoolPoint& intersect);
     static double polygonArea(const PolygonContour& contour);
     static void ensureWindingOrder(PolygonContour& contour, bool clockwise);
+    static bool buildContour(std::vector<BoolPoint>& points, PolygonContour& contour);
+
+    static std::vector<GridContour> snapContours(const std::vector<PolygonContour>& contours,
+                                                 double gridSize, bool& inRange);
+    static bool rayCrossesEdgeExact(const GridPoint& p, const GridPoint& from, const GridPoint& to);
+    static bool pointInPolygonExact(const GridPoint& p, const GridContour& contour);
+    static bool segmentsIntersectExact(const GridPoint& a1, const GridPoint& a2,
+                                       const GridPoint& b1, const GridPoint& b2,
+                                       GridPoint& intersect);
+    static bool buildContourExact(std::vector<GridPoint>& points, double gridSize,
+                                  PolygonContour& contour);
+};
+
+// Хранит пересечения рёбер и принадлежность вершин для каждой пары контуров,
+// поэтому перемещение, вставка или удаление одной вершины пересчитывает
+// только рёбра, смежные с ней, а не весь booleanOperation.
+class IncrementalPolygonBoolean {
+public:
+    enum Input { FIRST, SECOND };
+
+    IncrementalPolygonBoolean();
+
+    void setInput(const std::vector<PolygonContour>& poly1,
+                  const std::vector<PolygonContour>& poly2,
+                  PolygonBoolean::Operation op);
+    void setOperation(PolygonBoolean::Operation op);
+
+    void moveVertex(Input input, size_t contour, size_t index, const BoolPoint& p);
+    void insertVertex(Input input, size_t contour, size_t index, const BoolPoint& p);
+    void eraseVertex(Input input, size_t contour, size_t index);
+
+    const std::vector<PolygonContour>& result();
+
+private:
+    struct Crossing {
+        size_t edge1, edge2;
+        BoolPoint point;
+        Crossing(size_t e1, size_t e2, const BoolPoint& p) : edge1(e1), edge2(e2), point(p) {}
+    };
+
+    struct PairState {
+        std::vector<char> inside1;
+        std::vector<char> inside2;
+        std::vector<Crossing> crossings;
+    };
+
+    enum EditKind { EDIT_MOVE, EDIT_INSERT, EDIT_ERASE };
+
+    struct VertexEdit {
+        EditKind kind;
+        size_t vertex;
+        std::vector<size_t> removedEdges;
+        std::vector<BoolPoint> removedFrom, removedTo;
+        std::vector<size_t> addedEdges;
+    };
+
+    PairState& pairAt(size_t c1, size_t c2) { return pairs[c1 * poly2.size() + c2]; }
+    std::vector<PolygonContour>& contoursOf(Input input) { return input == FIRST ? poly1 : poly2; }
+    void rebuildPair(size_t c1, size_t c2);
+    void rebuildContourPairs(Input input, size_t contour);
+    void updatePair(Input input, size_t contour, size_t other, const VertexEdit& edit);
+    void applyEdit(Input input, size_t contour, const VertexEdit& edit);
+    void markDirty(Input input, size_t contour);
+    void buildSlot(size_t slot);
+
+    std::vector<PolygonContour> poly1;
+    std::vector<PolygonContour> poly2;
+    std::vector<PairState> pairs;
+    std::vector<PolygonContour> slotContours;
+    std::vector<char> slotValid;
+    std::vector<PolygonContour> resultContours;
+    PolygonBoolean::Operation operation;
+    bool resultDirty;
 };
 
 #endif
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 PolygonWidget::PolygonWidget(QWidget *parent) : QWidget(parent),
     currentMode(MODE_POLY1), currentOp(OP_UNION),
-    currentContourIdx(0), movingPointIdx(-1), movingContourIdx(-1),
+    currentContourIdx(0), movingPointIdx(-1), movingContourIdx(-1), movingPolygonIdx(-1),
     showFill(true), showGrid(false) {
 
     setMouseTracking(true);
@@ -17,7 +17,18 @@ PolygonWidget::PolygonWidget(QWidget *parent) : QWidget(parent),
 void PolygonWidget::setOperation(Operation op) {
     currentOp = op;
     if (currentMode == MODE_RESULT) {
-        computeResult();
+        switch (currentOp) {
+        case OP_UNION:
+            booleanState.setOperation(PolygonBoolean::UNION);
+            break;
+        case OP_INTERSECTION:
+            booleanState.setOperation(PolygonBoolean::INTERSECTION);
+            break;
+        case OP_DIFFERENCE:
+            booleanState.setOperation(PolygonBoolean::DIFFERENCE);
+            break;
+        }
+        refreshResult();
         update();
     }
 }
@@ -68,6 +79,7 @@ void PolygonWidget::reset() {
     poly1Contours.clear();
     poly2Contours.clear();
     resultContours.clear();
+    resultMesh.clear();
 
     poly1Contours.push_back(VisualContour());
     poly2Contours.push_back(VisualContour());
@@ -76,6 +88,7 @@ void PolygonWidget::reset() {
     currentContourIdx = 0;
     movingPointIdx = -1;
     movingContourIdx = -1;
+    movingPolygonIdx = -1;
 
     update();
 }
@@ -163,7 +176,7 @@ void PolygonWidget::paintEvent(QPaintEvent *event) {
 
         // 2. Рисуем результат операции БОЛЬШИМ ЯРКИМ ЦВЕТОМ
         painter.setOpacity(1.0);
-        drawPolygonContours(painter, resultContours, resultColor);
+        drawPolygonContours(painter, resultContours, resultMesh, resultColor);
 
         // 3. Обводим контуры исходных полигонов
         painter.setPen(QPen(poly1Color.darker(), 2));
@@ -263,11 +276,42 @@ void PolygonWidget::drawContour(QPainter& painter, const VisualContour& contour,
 
 void PolygonWidget::drawPolygonContours(QPainter& painter,
                                         const std::vector<PolygonContour>& contours,
+                                        const TriangleMesh& mesh,
                                         const QColor& color) {
     if (contours.empty()) return;
 
+    if (showFill) {
+        // Разные стили заливки для разных операций
+        QBrush brush(color);
+        if (currentOp == OP_INTERSECTION) {
+            // Для пересечения - диагональная штриховка
+            brush.setStyle(Qt::DiagCrossPattern);
+        } else if (currentOp == OP_DIFFERENCE) {
+            // Для разности - вертикальная штриховка
+            brush.setStyle(Qt::VerPattern);
+        }
+
+        // Заливка готовыми треугольниками: выпуклые многоугольники QPainter
+        // рисует без повторной тесселяции. Сглаживание выключено, чтобы
+        // между соседними треугольниками не было швов.
+        painter.save();
+        painter.setRenderHint(QPainter::Antialiasing, false);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(brush);
+        for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+            QPointF triangle[3];
+            for (int k = 0; k < 3; ++k) {
+                const BoolPoint& p = mesh.vertices[mesh.indices[t + k]];
+                triangle[k] = QPointF(p.x, p.y);
+            }
+            painter.drawConvexPolygon(triangle, 3);
+        }
+        painter.restore();
+    }
+
     // Яркая толстая обводка для результата
     painter.setPen(QPen(color.darker(), 3));
+    painter.setBrush(Qt::NoBrush);
 
     for (const auto& contour : contours) {
         if (contour.points.size() < 3) continue;
@@ -276,29 +320,18 @@ void PolygonWidget::drawPolygonContours(QPainter& painter,
         for (const auto& p : contour.points) {
             poly << QPointF(p.x, p.y);
         }
-
-        if (showFill) {
-            // Разные стили заливки для разных операций
-            QBrush brush(color);
-            if (currentOp == OP_INTERSECTION) {
-                // Для пересечения - диагональная штриховка
-                brush.setStyle(Qt::DiagCrossPattern);
-            } else if (currentOp == OP_DIFFERENCE) {
-                // Для разности - вертикальная штриховка
-                brush.setStyle(Qt::VerPattern);
-            }
-            painter.setBrush(brush);
-            painter.drawPolygon(poly);
-        } else {
-            painter.setBrush(Qt::NoBrush);
-            painter.drawPolygon(poly);
-        }
+        painter.drawPolygon(poly);
     }
 }
 
 void PolygonWidget::mousePressEvent(QMouseEvent *event) {
     QPointF pos = event->pos();
 
+    if (currentMode == MODE_RESULT) {
+        pressResultVertex(event);
+        return;
+    }
+
     std::vector<VisualContour>* contours = nullptr;
     if (currentMode == MODE_POLY1) contours = &poly1Contours;
     else if (currentMode == MODE_POLY2) contours = &poly2Contours;
@@ -342,6 +375,13 @@ void PolygonWidget::mousePressEvent(QMouseEvent *event) {
 }
 
 void PolygonWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (currentMode == MODE_RESULT) {
+        if (movingPointIdx >= 0 && movingContourIdx >= 0 && movingPolygonIdx >= 0) {
+            moveResultVertex(event->pos());
+        }
+        return;
+    }
+
     if (movingPointIdx >= 0 && movingContourIdx >= 0) {
         QPointF pos = event->pos();
 
@@ -363,6 +403,7 @@ void PolygonWidget::mouseReleaseEvent(QMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
         movingPointIdx = -1;
         movingContourIdx = -1;
+        movingPolygonIdx = -1;
     }
 }
 
@@ -402,6 +443,74 @@ std::vector<PolygonContour> PolygonWidget::convertToBoolContours(
     return result;
 }
 
+int PolygonWidget::boolContourIndex(const std::vector<VisualContour>& visualContours,
+                                    int visualIdx) const {
+    int index = 0;
+    for (int i = 0; i < visualIdx; ++i) {
+        if (visualContours[i].closed && visualContours[i].points.size() >= 3) ++index;
+    }
+    return index;
+}
+
+void PolygonWidget::pressResultVertex(QMouseEvent *event) {
+    QPointF pos = event->pos();
+
+    // В режиме результата вершины можно двигать (ЛКМ) и удалять (ПКМ),
+    // результат при этом пересчитывается только для затронутых рёбер
+    for (int polyIdx = 0; polyIdx < 2; ++polyIdx) {
+        auto& contours = polyIdx == 0 ? poly1Contours : poly2Contours;
+        auto input = polyIdx == 0 ? IncrementalPolygonBoolean::FIRST : IncrementalPolygonBoolean::SECOND;
+
+        for (size_t ci = 0; ci < contours.size(); ++ci) {
+            auto& contour = contours[ci];
+            if (!contour.closed || contour.points.size() < 3) continue;
+
+            for (size_t pi = 0; pi < contour.points.size(); ++pi) {
+                QPointF diff = contour.points[pi] - pos;
+                if (diff.x() * diff.x() + diff.y() * diff.y() >= 100) continue;
+
+                if (event->button() == Qt::LeftButton) {
+                    movingPolygonIdx = polyIdx;
+                    movingContourIdx = ci;
+                    movingPointIdx = pi;
+                } else if (event->button() == Qt::RightButton) {
+                    if (contour.points.size() > 3) {
+                        booleanState.eraseVertex(input, boolContourIndex(contours, ci), pi);
+                        contour.points.erase(contour.points.begin() + pi);
+                        refreshResult();
+                    } else {
+                        contour.points.erase(contour.points.begin() + pi);
+                        contour.closed = false;
+                        computeResult();
+                    }
+                    update();
+                }
+                return;
+            }
+        }
+    }
+}
+
+void PolygonWidget::moveResultVertex(const QPointF& pos) {
+    auto& contours = movingPolygonIdx == 0 ? poly1Contours : poly2Contours;
+    auto input = movingPolygonIdx == 0 ? IncrementalPolygonBoolean::FIRST : IncrementalPolygonBoolean::SECOND;
+
+    if (movingContourIdx >= contours.size()) return;
+    auto& contour = contours[movingContourIdx];
+    if (movingPointIdx >= contour.points.size()) return;
+
+    contour.points[movingPointIdx] = pos;
+    booleanState.moveVertex(input, boolContourIndex(contours, movingContourIdx),
+                            movingPointIdx, BoolPoint(pos.x(), pos.y()));
+    refreshResult();
+    update();
+}
+
+void PolygonWidget::refreshResult() {
+    resultContours = booleanState.result();
+    resultMesh = PolygonTriangulator::triangulateEach(resultContours);
+}
+
 void PolygonWidget::computeResult() {
     auto boolPoly1 = convertToBoolContours(poly1Contours);
     auto boolPoly2 = convertToBoolContours(poly2Contours);
@@ -419,7 +528,8 @@ void PolygonWidget::computeResult() {
         break;
     }
 
-    resultContours = PolygonBoolean::booleanOperation(boolPoly1, boolPoly2, boolOp);
+    booleanState.setInput(boolPoly1, boolPoly2, boolOp);
+    refreshResult();
 }
 
 MainWindow::MainWindow(QWidget *parent) : QWidget(parent) {
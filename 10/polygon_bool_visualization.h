@@ -11,6 +11,7 @@
 #include <QCheckBox>
 #include <vector>
 #include "polygon_bool_algorithms.h"
+#include "polygon_triangulation_algorithms.h"
 
 class PolygonWidget : public QWidget {
     Q_OBJECT
@@ -49,23 +50,31 @@ private:
                      const QColor& color, bool active);
     void drawPolygonContours(QPainter& painter, 
                              const std::vector<PolygonContour>& contours,
+                             const TriangleMesh& mesh,
                              const QColor& color);
     void drawLegend(QPainter& painter, const QColor& color1, 
                    const QColor& color2, const QColor& resultColor,
                    const QString& operation);
     void computeResult();
+    void refreshResult();
     std::vector<PolygonContour> convertToBoolContours(
         const std::vector<VisualContour>& visualContours);
+    int boolContourIndex(const std::vector<VisualContour>& visualContours, int visualIdx) const;
+    void pressResultVertex(QMouseEvent *event);
+    void moveResultVertex(const QPointF& pos);
     
     std::vector<VisualContour> poly1Contours;
     std::vector<VisualContour> poly2Contours;
     std::vector<PolygonContour> resultContours;
+    TriangleMesh resultMesh;
+    IncrementalPolygonBoolean booleanState;
     
     Mode currentMode;
     Operation currentOp;
     int currentContourIdx;
     int movingPointIdx;
     int movingContourIdx;
+    int movingPolygonIdx;
     
     bool showFill;
     bool showGrid;
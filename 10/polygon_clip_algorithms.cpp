@@ -0,0 +1,248 @@
+#include "polygon_clip_algorithms.h"
+#include <algorithm>
+
+PolygonClipper::SoAContour PolygonClipper::toSoA(const PolygonContour& contour) {
+    SoAContour soa;
+    soa.xs.resize(contour.points.size());
+    soa.ys.resize(contour.points.size());
+    for (size_t i = 0; i < contour.points.size(); i++) {
+        soa.xs[i] = contour.points[i].x;
+        soa.ys[i] = contour.points[i].y;
+    }
+    return soa;
+}
+
+PolygonContour PolygonClipper::fromSoA(const SoAContour& soa, bool isHole) {
+    PolygonContour contour;
+    if (soa.size() < 3) return contour;
+
+    contour.points.reserve(soa.size());
+    for (size_t i = 0; i < soa.size(); i++) {
+        contour.points.push_back(BoolPoint(soa.xs[i], soa.ys[i]));
+    }
+    contour.isHole = isHole;
+    return contour;
+}
+
+ClipRect PolygonClipper::bounds(const SoAContour& soa) {
+    if (soa.size() == 0) return ClipRect();
+
+    auto xr = std::minmax_element(soa.xs.begin(), soa.xs.end());
+    auto yr = std::minmax_element(soa.ys.begin(), soa.ys.end());
+    return ClipRect(*xr.first, *yr.first, *xr.second, *yr.second);
+}
+
+void PolygonClipper::splitByPlane(const SoAContour& in, const HalfPlane& plane,
+                                  SoAContour* inside, SoAContour* outside,
+                                  std::vector<double>& distances) {
+    size_t n = in.size();
+    if (inside) {
+        inside->xs.clear();
+        inside->ys.clear();
+    }
+    if (outside) {
+        outside->xs.clear();
+        outside->ys.clear();
+    }
+    if (n == 0) return;
+
+    distances.resize(n);
+    const double* xs = in.xs.data();
+    const double* ys = in.ys.data();
+    double* d = distances.data();
+    for (size_t i = 0; i < n; i++) {
+        d[i] = plane.a * xs[i] + plane.b * ys[i] + plane.c;
+    }
+
+    for (size_t i = 0, prev = n - 1; i < n; prev = i++) {
+        double dp = d[prev];
+        double dc = d[i];
+
+        if ((dp < 0 && dc > 0) || (dp > 0 && dc < 0)) {
+            double t = dp / (dp - dc);
+            double ix = xs[prev] + t * (xs[i] - xs[prev]);
+            double iy = ys[prev] + t * (ys[i] - ys[prev]);
+            if (inside) {
+                inside->xs.push_back(ix);
+                inside->ys.push_back(iy);
+            }
+            if (outside) {
+                outside->xs.push_back(ix);
+                outside->ys.push_back(iy);
+            }
+        }
+
+        if (inside && dc >= 0) {
+            inside->xs.push_back(xs[i]);
+            inside->ys.push_back(ys[i]);
+        }
+        if (outside && dc <= 0) {
+            outside->xs.push_back(xs[i]);
+            outside->ys.push_back(ys[i]);
+        }
+    }
+}
+
+PolygonContour PolygonClipper::clipToHalfPlane(const PolygonContour& contour, const HalfPlane& plane) {
+    SoAContour in = toSoA(contour);
+    SoAContour out;
+    std::vector<double> distances;
+    splitByPlane(in, plane, &out, nullptr, distances);
+    return fromSoA(out, contour.isHole);
+}
+
+std::vector<PolygonContour> PolygonClipper::clipToHalfPlane(const std::vector<PolygonContour>& contours,
+                                                            const HalfPlane& plane) {
+    std::vector<PolygonContour> result;
+    for (const auto& contour : contours) {
+        PolygonContour clipped = clipToHalfPlane(contour, plane);
+        if (!clipped.points.empty()) result.push_back(clipped);
+    }
+    return result;
+}
+
+PolygonContour PolygonClipper::clipToRect(const PolygonContour& contour, const ClipRect& rect) {
+    if (contour.points.size() < 3) return PolygonContour();
+
+    SoAContour current = toSoA(contour);
+    ClipRect box = bounds(current);
+
+    if (box.maxX < rect.minX || box.minX > rect.maxX ||
+        box.maxY < rect.minY || box.minY > rect.maxY) {
+        return PolygonContour();
+    }
+    if (box.minX >= rect.minX && box.maxX <= rect.maxX &&
+        box.minY >= rect.minY && box.maxY <= rect.maxY) {
+        return contour;
+    }
+
+    const HalfPlane planes[4] = {
+        HalfPlane(1, 0, -rect.minX),
+        HalfPlane(-1, 0, rect.maxX),
+        HalfPlane(0, 1, -rect.minY),
+        HalfPlane(0, -1, rect.maxY)
+    };
+    const bool needed[4] = {
+        box.minX < rect.minX, box.maxX > rect.maxX,
+        box.minY < rect.minY, box.maxY > rect.maxY
+    };
+
+    SoAContour next;
+    std::vector<double> distances;
+    for (int k = 0; k < 4 && current.size() >= 3; k++) {
+        if (!needed[k]) continue;
+        splitByPlane(current, planes[k], &next, nullptr, distances);
+        std::swap(current, next);
+    }
+
+    return fromSoA(current, contour.isHole);
+}
+
+std::vector<PolygonContour> PolygonClipper::clipToRect(const std::vector<PolygonContour>& contours,
+                                                       const ClipRect& rect) {
+    std::vector<PolygonContour> result;
+    for (const auto& contour : contours) {
+        PolygonContour clipped = clipToRect(contour, rect);
+        if (!clipped.points.empty()) result.push_back(clipped);
+    }
+    return result;
+}
+
+std::vector<std::vector<PolygonContour>> PolygonClipper::clipToGrid(
+    const std::vector<PolygonContour>& contours,
+    const ClipRect& gridBounds, int columns, int rows) {
+
+    std::vector<std::vector<PolygonContour>> tiles;
+    if (columns <= 0 || rows <= 0) return tiles;
+    tiles.resize(static_cast<size_t>(columns) * rows);
+
+    double cellW = (gridBounds.maxX - gridBounds.minX) / columns;
+    double cellH = (gridBounds.maxY - gridBounds.minY) / rows;
+    if (!(cellW > 0) || !(cellH > 0)) return tiles;
+
+    auto columnOf = [&](double x) {
+        int c = static_cast<int>(std::floor((x - gridBounds.minX) / cellW));
+        return std::max(0, std::min(columns - 1, c));
+    };
+    auto rowOf = [&](double y) {
+        int r = static_cast<int>(std::floor((y - gridBounds.minY) / cellH));
+        return std::max(0, std::min(rows - 1, r));
+    };
+
+    SoAContour remaining, rest, strip, restStrip, tile;
+    std::vector<double> distances;
+
+    for (const auto& contour : contours) {
+        PolygonContour clipped = clipToRect(contour, gridBounds);
+        if (clipped.points.size() < 3) continue;
+
+        remaining = toSoA(clipped);
+        ClipRect box = bounds(remaining);
+        int c0 = columnOf(box.minX), c1 = columnOf(box.maxX);
+
+        for (int c = c0; c <= c1 && remaining.size() >= 3; c++) {
+            if (c < c1) {
+                double x = gridBounds.minX + (c + 1) * cellW;
+                splitByPlane(remaining, HalfPlane(-1, 0, x), &strip, &rest, distances);
+                std::swap(remaining, rest);
+            } else {
+                std::swap(strip, remaining);
+                remaining.xs.clear();
+                remaining.ys.clear();
+            }
+            if (strip.size() < 3) continue;
+
+            ClipRect stripBox = bounds(strip);
+            int r0 = rowOf(stripBox.minY), r1 = rowOf(stripBox.maxY);
+
+            for (int r = r0; r <= r1 && strip.size() >= 3; r++) {
+                if (r < r1) {
+                    double y = gridBounds.minY + (r + 1) * cellH;
+                    splitByPlane(strip, HalfPlane(0, -1, y), &tile, &restStrip, distances);
+                    std::swap(strip, restStrip);
+                } else {
+                    std::swap(tile, strip);
+                    strip.xs.clear();
+                    strip.ys.clear();
+                }
+
+                PolygonContour piece = fromSoA(tile, contour.isHole);
+                if (!piece.points.empty()) {
+                    tiles[static_cast<size_t>(r) * columns + c].push_back(piece);
+                }
+            }
+        }
+    }
+
+    return tiles;
+}
+
+bool PolygonClipper::clipSegment(BoolPoint& a, BoolPoint& b, const ClipRect& rect) {
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double t0 = 0, t1 = 1;
+
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] = { a.x - rect.minX, rect.maxX - a.x, a.y - rect.minY, rect.maxY - a.y };
+
+    for (int k = 0; k < 4; k++) {
+        if (p[k] == 0) {
+            if (q[k] < 0) return false;
+            continue;
+        }
+        double t = q[k] / p[k];
+        if (p[k] < 0) {
+            if (t > t1) return false;
+            if (t > t0) t0 = t;
+        } else {
+            if (t < t0) return false;
+            if (t < t1) t1 = t;
+        }
+    }
+
+    BoolPoint start(a.x + t0 * dx, a.y + t0 * dy);
+    BoolPoint end(a.x + t1 * dx, a.y + t1 * dy);
+    a = start;
+    b = end;
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef POLYGON_CLIP_ALGORITHMS_H
+#define POLYGON_CLIP_ALGORITHMS_H
+
+#include <vector>
+#include "polygon_bool_algorithms.h"
+
+struct ClipRect {
+    double minX, minY, maxX, maxY;
+    ClipRect(double minX = 0, double minY = 0, double maxX = 0, double maxY = 0)
+        : minX(minX), minY(minY), maxX(maxX), maxY(maxY) {}
+};
+
+// Полуплоскость a*x + b*y + c >= 0
+struct HalfPlane {
+    double a, b, c;
+    HalfPlane(double a = 0, double b = 0, double c = 0) : a(a), b(b), c(c) {}
+};
+
+// Отсечение Сазерленда–Ходжмана прямоугольником и полуплоскостями за
+// линейное время. Вершины хранятся в виде отдельных массивов x и y, чтобы
+// расстояния до прямой считались одним векторизуемым циклом.
+class PolygonClipper {
+public:
+    static PolygonContour clipToHalfPlane(const PolygonContour& contour, const HalfPlane& plane);
+    static std::vector<PolygonContour> clipToHalfPlane(const std::vector<PolygonContour>& contours,
+                                                       const HalfPlane& plane);
+
+    static PolygonContour clipToRect(const PolygonContour& contour, const ClipRect& rect);
+    static std::vector<PolygonContour> clipToRect(const std::vector<PolygonContour>& contours,
+                                                  const ClipRect& rect);
+
+    // Разрезает многоугольник сеткой columns x rows плиток, покрывающей bounds,
+    // за один проход: сначала на вертикальные полосы, затем полосы на плитки.
+    // Результат индексируется как row * columns + column.
+    static std::vector<std::vector<PolygonContour>> clipToGrid(
+        const std::vector<PolygonContour>& contours,
+        const ClipRect& bounds, int columns, int rows);
+
+    // Отсечение отрезка Лианга–Барски, false если отрезок целиком снаружи
+    static bool clipSegment(BoolPoint& a, BoolPoint& b, const ClipRect& rect);
+
+private:
+    struct SoAContour {
+        std::vector<double> xs, ys;
+        size_t size() const { return xs.size(); }
+    };
+
+    static SoAContour toSoA(const PolygonContour& contour);
+    static PolygonContour fromSoA(const SoAContour& soa, bool isHole);
+    static void splitByPlane(const SoAContour& in, const HalfPlane& plane,
+                             SoAContour* inside, SoAContour* outside,
+                             std::vector<double>& distances);
+    static ClipRect bounds(const SoAContour& soa);
+};
+
+#endif
@@ -0,0 +1,318 @@
+#include "polygon_overlap_algorithms.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+// Полос столько же, сколько рёбер, но суммарная длина списков полос
+// ограничена восемью на ребро: иначе длинные рёбра попадали бы в каждую
+void PolygonOverlap::prepare(const std::vector<PolygonContour>& polygon, Region& region,
+                             std::vector<double>& params) {
+    region.edges.clear();
+    region.minX = region.minY = std::numeric_limits<double>::infinity();
+    region.maxX = region.maxY = -std::numeric_limits<double>::infinity();
+    for (const auto& contour : polygon) {
+        const auto& points = contour.points;
+        if (points.size() < 3) continue;
+
+        for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+            Segment edge;
+            edge.from = points[j];
+            edge.to = points[i];
+            region.edges.push_back(edge);
+            region.minX = std::min(region.minX, points[i].x);
+            region.minY = std::min(region.minY, points[i].y);
+            region.maxX = std::max(region.maxX, points[i].x);
+            region.maxY = std::max(region.maxY, points[i].y);
+        }
+    }
+
+    size_t count = region.edges.size();
+    size_t bins = std::max<size_t>(1, count);
+    size_t total = 0;
+    while (true) {
+        region.binHeight = (region.maxY - region.minY) / bins;
+        if (!(region.binHeight > 0) || !std::isfinite(region.binHeight)) {
+            bins = 1;
+            region.binHeight = 1;
+        }
+        region.binStart.assign(bins + 1, 0);
+        total = 0;
+        for (const auto& edge : region.edges) {
+            size_t lo = binOf(region, std::min(edge.from.y, edge.to.y));
+            size_t hi = binOf(region, std::max(edge.from.y, edge.to.y));
+            total += hi - lo + 1;
+        }
+        if (bins == 1 || total <= 8 * count) break;
+        bins /= 2;
+    }
+
+    for (const auto& edge : region.edges) {
+        size_t lo = binOf(region, std::min(edge.from.y, edge.to.y));
+        size_t hi = binOf(region, std::max(edge.from.y, edge.to.y));
+        for (size_t b = lo; b <= hi; b++) region.binStart[b + 1]++;
+    }
+    for (size_t b = 0; b < bins; b++) region.binStart[b + 1] += region.binStart[b];
+    region.binEdges.resize(total);
+    std::vector<size_t> fill(region.binStart.begin(), region.binStart.end() - 1);
+    for (size_t e = 0; e < count; e++) {
+        const Segment& edge = region.edges[e];
+        size_t lo = binOf(region, std::min(edge.from.y, edge.to.y));
+        size_t hi = binOf(region, std::max(edge.from.y, edge.to.y));
+        for (size_t b = lo; b <= hi; b++) region.binEdges[fill[b]++] = e;
+    }
+
+    // Рёбра режутся в точках самопересечений и пересечений контуров, и каждый
+    // кусок ориентируется по чётно-нечётному правилу
+    region.boundary.clear();
+    for (size_t e = 0; e < count; e++) {
+        const BoolPoint& from = region.edges[e].from;
+        BoolPoint d = region.edges[e].to - from;
+        // Горизонтальные куски ничего не дают в интеграл x dy
+        if (d.y == 0) continue;
+
+        params.clear();
+        params.push_back(0.0);
+        params.push_back(1.0);
+        splitParams(from, d, region, params);
+        std::sort(params.begin(), params.end());
+
+        for (size_t k = 0; k + 1 < params.size(); k++) {
+            double t0 = params[k];
+            double t1 = params[k + 1];
+            if (t1 - t0 < 1e-12) continue;
+
+            double tm = (t0 + t1) / 2;
+            bool left, right;
+            size_t firstOnEdge;
+            sides(BoolPoint(from.x + tm * d.x, from.y + tm * d.y), d, region, left, right, firstOnEdge);
+            // Совпадающие куски нескольких рёбер берутся один раз, у первого ребра
+            if (left == right || firstOnEdge < e) continue;
+
+            Segment piece;
+            piece.from = BoolPoint(from.x + t0 * d.x, from.y + t0 * d.y);
+            piece.to = BoolPoint(from.x + t1 * d.x, from.y + t1 * d.y);
+            if (!left) std::swap(piece.from, piece.to);
+            region.boundary.push_back(piece);
+        }
+    }
+}
+
+size_t PolygonOverlap::binOf(const Region& region, double y) {
+    size_t bins = region.binStart.size() - 1;
+    double f = (y - region.minY) / region.binHeight;
+    if (!(f > 0)) return 0;
+    if (f >= static_cast<double>(bins)) return bins - 1;
+    return static_cast<size_t>(f);
+}
+
+void PolygonOverlap::splitParams(const BoolPoint& from, const BoolPoint& d, const Region& region,
+                                 std::vector<double>& params) {
+    if (region.edges.empty()) return;
+
+    // Ребро из нескольких полос встречается несколько раз; повторные
+    // параметры дают куски нулевой длины, и они пропускаются
+    size_t lo = binOf(region, std::min(from.y, from.y + d.y));
+    size_t hi = binOf(region, std::max(from.y, from.y + d.y));
+    for (size_t n = region.binStart[lo]; n < region.binStart[hi + 1]; n++) {
+        const Segment& edge = region.edges[region.binEdges[n]];
+        BoolPoint e = edge.to - edge.from;
+        BoolPoint w = edge.from - from;
+        double denom = d.cross(e);
+        if (std::abs(denom) < 1e-12) {
+            // Параллельные рёбра режут друг друга только на общей прямой
+            double len2 = d.dot(d);
+            if (len2 > 0 && std::abs(d.cross(w)) <= 1e-9 * std::sqrt(len2)) {
+                double t0 = w.dot(d) / len2;
+                double t1 = (edge.to - from).dot(d) / len2;
+                if (t0 > 0 && t0 < 1) params.push_back(t0);
+                if (t1 > 0 && t1 < 1) params.push_back(t1);
+            }
+            continue;
+        }
+        double t = w.cross(e) / denom;
+        double u = w.cross(d) / denom;
+        if (t > 0 && t < 1 && u >= 0 && u <= 1) params.push_back(t);
+    }
+}
+
+// Принадлежность region точек чуть левее и чуть правее направления d в точке p.
+// Чётность считается лучом вправо. Рёбра, на которых лежит p, в неё не входят:
+// точку чуть меньшего x их луч пересекает все, чуть большего — ни одного.
+// При d.y > 0 слева лежит сторона меньших x. В firstOnEdge — номер первого
+// ребра region, на котором лежит p.
+void PolygonOverlap::sides(const BoolPoint& p, const BoolPoint& d, const Region& region,
+                           bool& left, bool& right, size_t& firstOnEdge) {
+    bool parity = false;
+    bool onEdges = false;
+    firstOnEdge = std::numeric_limits<size_t>::max();
+    if (!region.edges.empty()) {
+        // Все рёбра, пересекающие высоту p.y, лежат в её полосе, и каждое один раз
+        size_t bin = binOf(region, p.y);
+        for (size_t n = region.binStart[bin]; n < region.binStart[bin + 1]; n++) {
+            const BoolPoint& from = region.edges[region.binEdges[n]].from;
+            const BoolPoint& to = region.edges[region.binEdges[n]].to;
+            BoolPoint edge = to - from;
+            BoolPoint rel = p - from;
+
+            double len2 = edge.dot(edge);
+            double along = rel.dot(edge);
+            if (std::abs(edge.cross(rel)) <= 1e-9 * std::sqrt(len2) && along >= 0 && along <= len2) {
+                onEdges = !onEdges;
+                firstOnEdge = std::min(firstOnEdge, region.binEdges[n]);
+                continue;
+            }
+
+            if (((to.y > p.y) != (from.y > p.y)) &&
+                (p.x < (from.x - to.x) * (p.y - to.y) / (from.y - to.y) + to.x)) {
+                parity = !parity;
+            }
+        }
+    }
+    bool lowerX = parity != onEdges;
+    left = d.y > 0 ? lowerX : parity;
+    right = d.y > 0 ? parity : lowerX;
+}
+
+double PolygonOverlap::boundaryArea(const Region& region) {
+    double area = 0;
+    for (const auto& piece : region.boundary) {
+        area += (piece.from.x + piece.to.x) / 2 * (piece.to.y - piece.from.y);
+    }
+    return area;
+}
+
+// Интеграл x dy по кускам границы owner внутри region. Кусок на границе region
+// берётся, если region лежит слева от него, и только у владельца общей
+// границы: так совпадающие участки A и B учитываются один раз.
+double PolygonOverlap::clippedIntegral(const Region& owner, const Region& region, bool ownsSharedBoundary,
+                                       std::vector<double>& params) {
+    double integral = 0;
+    for (const auto& piece : owner.boundary) {
+        const BoolPoint& from = piece.from;
+        BoolPoint d = piece.to - from;
+
+        params.clear();
+        params.push_back(0.0);
+        params.push_back(1.0);
+        splitParams(from, d, region, params);
+        std::sort(params.begin(), params.end());
+
+        for (size_t k = 0; k + 1 < params.size(); k++) {
+            double t0 = params[k];
+            double t1 = params[k + 1];
+            if (t1 - t0 < 1e-12) continue;
+
+            double tm = (t0 + t1) / 2;
+            bool left, right;
+            size_t firstOnEdge;
+            sides(BoolPoint(from.x + tm * d.x, from.y + tm * d.y), d, region, left, right, firstOnEdge);
+            if (!left || (left != right && !ownsSharedBoundary)) continue;
+
+            double x0 = from.x + t0 * d.x;
+            double x1 = from.x + t1 * d.x;
+            integral += (x0 + x1) / 2 * (t1 - t0) * d.y;
+        }
+    }
+    return integral;
+}
+
+double PolygonOverlap::overlapArea(const Region& a, const Region& b, std::vector<double>& params) {
+    if (!(a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY)) return 0.0;
+
+    double area = clippedIntegral(a, b, true, params) + clippedIntegral(b, a, false, params);
+    return std::max(0.0, area);
+}
+
+double PolygonOverlap::regionArea(const std::vector<PolygonContour>& polygon) {
+    Region region;
+    std::vector<double> params;
+    prepare(polygon, region, params);
+    return boundaryArea(region);
+}
+
+double PolygonOverlap::overlapArea(const std::vector<PolygonContour>& a,
+                                   const std::vector<PolygonContour>& b) {
+    Region regionA, regionB;
+    std::vector<double> params;
+    prepare(a, regionA, params);
+    prepare(b, regionB, params);
+    return overlapArea(regionA, regionB, params);
+}
+
+double PolygonOverlap::intersectionOverUnion(const std::vector<PolygonContour>& a,
+                                             const std::vector<PolygonContour>& b) {
+    Region regionA, regionB;
+    std::vector<double> params;
+    prepare(a, regionA, params);
+    prepare(b, regionB, params);
+    double inter = overlapArea(regionA, regionB, params);
+    double uni = boundaryArea(regionA) + boundaryArea(regionB) - inter;
+    return uni > 0 ? inter / uni : 0.0;
+}
+
+std::vector<double> PolygonOverlap::runPairs(const std::vector<std::vector<PolygonContour>>& polygons,
+                                             const std::vector<std::pair<size_t, size_t>>& pairs,
+                                             int threads, bool iou) {
+    std::vector<double> result(pairs.size(), 0.0);
+
+    // Многоугольники готовятся один раз, а не на каждую пару
+    std::vector<Region> regions(polygons.size());
+    std::vector<double> areas;
+    {
+        std::vector<double> params;
+        for (size_t i = 0; i < polygons.size(); i++) prepare(polygons[i], regions[i], params);
+    }
+    if (iou) {
+        areas.resize(polygons.size());
+        for (size_t i = 0; i < polygons.size(); i++) areas[i] = boundaryArea(regions[i]);
+    }
+
+    // Пары раздаются блоками, чтобы не дёргать атомарный счётчик на каждую
+    const size_t blockSize = 256;
+    std::atomic<size_t> nextBlock(0);
+    auto worker = [&]() {
+        std::vector<double> params;
+        for (size_t begin = nextBlock.fetch_add(blockSize); begin < pairs.size();
+             begin = nextBlock.fetch_add(blockSize)) {
+            size_t end = std::min(pairs.size(), begin + blockSize);
+            for (size_t k = begin; k < end; k++) {
+                size_t a = pairs[k].first;
+                size_t b = pairs[k].second;
+                double inter = overlapArea(regions[a], regions[b], params);
+                if (iou) {
+                    double uni = areas[a] + areas[b] - inter;
+                    result[k] = uni > 0 ? inter / uni : 0.0;
+                } else {
+                    result[k] = inter;
+                }
+            }
+        }
+    };
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocks = (pairs.size() + blockSize - 1) / blockSize;
+    threads = static_cast<int>(std::min<size_t>(threads, blocks));
+    if (threads <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (auto& thread : pool) thread.join();
+    }
+    return result;
+}
+
+std::vector<double> PolygonOverlap::overlapAreas(const std::vector<std::vector<PolygonContour>>& polygons,
+                                                 const std::vector<std::pair<size_t, size_t>>& pairs,
+                                                 int threads) {
+    return runPairs(polygons, pairs, threads, false);
+}
+
+std::vector<double> PolygonOverlap::intersectionOverUnions(
+    const std::vector<std::vector<PolygonContour>>& polygons,
+    const std::vector<std::pair<size_t, size_t>>& pairs,
+    int threads) {
+    return runPairs(polygons, pairs, threads, true);
+}
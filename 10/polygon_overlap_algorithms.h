@@ -0,0 +1,66 @@
+#ifndef POLYGON_OVERLAP_ALGORITHMS_H
+#define POLYGON_OVERLAP_ALGORITHMS_H
+
+#include <utility>
+#include <vector>
+#include "polygon_bool_algorithms.h"
+
+// Площадь пересечения без построения контуров результата. По формуле Грина
+// площадь A ∩ B — интеграл x dy по границе пересечения, а эта граница
+// состоит из частей границы A внутри B и частей границы B внутри A. Области
+// задаются по чётно-нечётному правилу: рёбра многоугольника сначала режутся
+// в точках самопересечений и пересечений контуров между собой, и каждый
+// кусок ориентируется так, чтобы область лежала слева. Куски, по обе стороны
+// которых область одна и та же, отбрасываются. Затем куски границы A режутся
+// рёбрами B и наоборот, и в сумму попадают только внутренние. Ориентация и
+// вложенность контуров на входе могут быть любыми.
+class PolygonOverlap {
+public:
+    static double regionArea(const std::vector<PolygonContour>& polygon);
+    static double overlapArea(const std::vector<PolygonContour>& a,
+                              const std::vector<PolygonContour>& b);
+    static double intersectionOverUnion(const std::vector<PolygonContour>& a,
+                                        const std::vector<PolygonContour>& b);
+
+    // Пакетные варианты для пар индексов в polygons, threads = 0 — по числу
+    // аппаратных потоков
+    static std::vector<double> overlapAreas(const std::vector<std::vector<PolygonContour>>& polygons,
+                                            const std::vector<std::pair<size_t, size_t>>& pairs,
+                                            int threads = 1);
+    static std::vector<double> intersectionOverUnions(
+        const std::vector<std::vector<PolygonContour>>& polygons,
+        const std::vector<std::pair<size_t, size_t>>& pairs,
+        int threads = 1);
+
+private:
+    struct Segment {
+        BoolPoint from, to;
+    };
+
+    // Многоугольник, подготовленный к запросам. Рёбра разложены по
+    // горизонтальным полосам: запрос на высоте y или на отрезке высот
+    // просматривает только рёбра своих полос. boundary — куски границы
+    // по чётно-нечётному правилу, область слева от каждого куска.
+    struct Region {
+        std::vector<Segment> edges;
+        std::vector<size_t> binStart, binEdges;
+        double minX, minY, maxX, maxY, binHeight;
+        std::vector<Segment> boundary;
+    };
+
+    static void prepare(const std::vector<PolygonContour>& polygon, Region& region, std::vector<double>& params);
+    static size_t binOf(const Region& region, double y);
+    static void splitParams(const BoolPoint& from, const BoolPoint& d, const Region& region,
+                            std::vector<double>& params);
+    static void sides(const BoolPoint& p, const BoolPoint& d, const Region& region,
+                      bool& left, bool& right, size_t& firstOnEdge);
+    static double boundaryArea(const Region& region);
+    static double clippedIntegral(const Region& owner, const Region& region, bool ownsSharedBoundary,
+                                  std::vector<double>& params);
+    static double overlapArea(const Region& a, const Region& b, std::vector<double>& params);
+    static std::vector<double> runPairs(const std::vector<std::vector<PolygonContour>>& polygons,
+                                        const std::vector<std::pair<size_t, size_t>>& pairs,
+                                        int threads, bool iou);
+};
+
+#endif
@@ -0,0 +1,391 @@
+#include "polygon_simplify_algorithms.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <queue>
+#include <thread>
+
+static double segmentDistance(const BoolPoint& p, const BoolPoint& a, const BoolPoint& b) {
+    BoolPoint ab = b - a;
+    BoolPoint ap = p - a;
+    double len2 = ab.dot(ab);
+    if (len2 < 1e-24) return std::sqrt(ap.dot(ap));
+
+    double t = std::max(0.0, std::min(1.0, ap.dot(ab) / len2));
+    double dx = ap.x - t * ab.x;
+    double dy = ap.y - t * ab.y;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+static bool properlyCross(const BoolPoint& a1, const BoolPoint& a2,
+                          const BoolPoint& b1, const BoolPoint& b2) {
+    double o1 = (a2 - a1).cross(b1 - a1);
+    double o2 = (a2 - a1).cross(b2 - a1);
+    double o3 = (b2 - b1).cross(a1 - b1);
+    double o4 = (b2 - b1).cross(a2 - b1);
+    return ((o1 > 0 && o2 < 0) || (o1 < 0 && o2 > 0)) &&
+           ((o3 > 0 && o4 < 0) || (o3 < 0 && o4 > 0));
+}
+
+void PolygonSimplifier::SpatialIndex::build(const std::vector<PolygonContour>& contours, bool edges) {
+    double maxX = 0, maxY = 0;
+    size_t total = 0;
+    minX = minY = 0;
+    for (const auto& contour : contours) {
+        for (const auto& p : contour.points) {
+            if (total == 0) {
+                minX = maxX = p.x;
+                minY = maxY = p.y;
+            }
+            minX = std::min(minX, p.x);
+            minY = std::min(minY, p.y);
+            maxX = std::max(maxX, p.x);
+            maxY = std::max(maxY, p.y);
+            total++;
+        }
+    }
+
+    int side = std::max(1, std::min(1024, static_cast<int>(std::sqrt(static_cast<double>(total)))));
+    double extent = std::max(maxX - minX, maxY - minY);
+    cellSize = extent > 0 ? extent / side : 1.0;
+    columns = std::max(1, static_cast<int>((maxX - minX) / cellSize) + 1);
+    rows = std::max(1, static_cast<int>((maxY - minY) / cellSize) + 1);
+    cells.assign(static_cast<size_t>(columns) * rows, std::vector<ItemRef>());
+
+    for (size_t c = 0; c < contours.size(); c++) {
+        const auto& points = contours[c].points;
+        for (size_t i = 0; i < points.size(); i++) {
+            const BoolPoint& a = points[i];
+            const BoolPoint& b = edges ? points[(i + 1) % points.size()] : a;
+            int c0, r0, c1, r1;
+            cellRange(std::min(a.x, b.x), std::min(a.y, b.y),
+                      std::max(a.x, b.x), std::max(a.y, b.y), c0, r0, c1, r1);
+            for (int r = r0; r <= r1; r++) {
+                for (int col = c0; col <= c1; col++) {
+                    cells[static_cast<size_t>(r) * columns + col].push_back(
+                        ItemRef(static_cast<int>(c), static_cast<int>(i)));
+                }
+            }
+        }
+    }
+}
+
+void PolygonSimplifier::SpatialIndex::cellRange(double x0, double y0, double x1, double y1,
+                                                int& c0, int& r0, int& c1, int& r1) const {
+    auto clampCell = [](double v, int limit) {
+        return std::max(0, std::min(limit - 1, static_cast<int>(std::floor(v))));
+    };
+    c0 = clampCell((x0 - minX) / cellSize, columns);
+    c1 = clampCell((x1 - minX) / cellSize, columns);
+    r0 = clampCell((y0 - minY) / cellSize, rows);
+    r1 = clampCell((y1 - minY) / cellSize, rows);
+}
+
+bool PolygonSimplifier::shortcutCrosses(const std::vector<PolygonContour>& contours, int contour,
+                                        int from, int to, const SpatialIndex& edges) {
+    const auto& points = contours[contour].points;
+    int n = static_cast<int>(points.size());
+    const BoolPoint& a = points[from % n];
+    const BoolPoint& b = points[to % n];
+
+    int c0, r0, c1, r1;
+    edges.cellRange(std::min(a.x, b.x), std::min(a.y, b.y),
+                    std::max(a.x, b.x), std::max(a.y, b.y), c0, r0, c1, r1);
+    for (int r = r0; r <= r1; r++) {
+        for (int col = c0; col <= c1; col++) {
+            for (const auto& ref : edges.cells[static_cast<size_t>(r) * edges.columns + col]) {
+                // Рёбра, которые заменяет новое ребро, не проверяются
+                if (ref.contour == contour && ref.index >= from && ref.index < to) continue;
+
+                const auto& other = contours[ref.contour].points;
+                const BoolPoint& e1 = other[ref.index];
+                const BoolPoint& e2 = other[(ref.index + 1) % other.size()];
+                if (properlyCross(a, b, e1, e2)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Отрезанный новым ребром «карман» — цепочка from..to вместе с самим ребром.
+// Если ребро ничего не пересекает, другой контур лежит в кармане целиком или
+// целиком вне его, поэтому достаточно проверить одну его вершину.
+bool PolygonSimplifier::pocketHoldsContour(const std::vector<PolygonContour>& contours, int contour,
+                                           int from, int to, const SpatialIndex& edges) {
+    const auto& points = contours[contour].points;
+    int n = static_cast<int>(points.size());
+    double x0 = points[from % n].x, x1 = x0, y0 = points[from % n].y, y1 = y0;
+    for (int i = from + 1; i <= to; i++) {
+        const BoolPoint& p = points[i % n];
+        x0 = std::min(x0, p.x);
+        y0 = std::min(y0, p.y);
+        x1 = std::max(x1, p.x);
+        y1 = std::max(y1, p.y);
+    }
+
+    auto inside = [&](const BoolPoint& p) {
+        bool result = false;
+        for (int i = from; i <= to; i++) {
+            const BoolPoint& a = points[i % n];
+            const BoolPoint& b = points[(i == to ? from : i + 1) % n];
+            if (((a.y > p.y) != (b.y > p.y)) && (p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x)) {
+                result = !result;
+            }
+        }
+        return result;
+    };
+
+    std::vector<int> checked;
+    int c0, r0, c1, r1;
+    edges.cellRange(x0, y0, x1, y1, c0, r0, c1, r1);
+    for (int r = r0; r <= r1; r++) {
+        for (int col = c0; col <= c1; col++) {
+            for (const auto& ref : edges.cells[static_cast<size_t>(r) * edges.columns + col]) {
+                if (ref.contour == contour ||
+                    std::find(checked.begin(), checked.end(), ref.contour) != checked.end()) {
+                    continue;
+                }
+                checked.push_back(ref.contour);
+                const BoolPoint& p = contours[ref.contour].points[ref.index];
+                if (p.x >= x0 && p.x <= x1 && p.y >= y0 && p.y <= y1 && inside(p)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool PolygonSimplifier::shortcutAllowed(const std::vector<PolygonContour>& contours, int contour,
+                                        int from, int to, const SpatialIndex& edges) {
+    return !shortcutCrosses(contours, contour, from, to, edges) &&
+           !pocketHoldsContour(contours, contour, from, to, edges);
+}
+
+bool PolygonSimplifier::triangleContains(const BoolPoint& a, const BoolPoint& b, const BoolPoint& c,
+                                         const BoolPoint& p) {
+    double d1 = (b - a).cross(p - a);
+    double d2 = (c - b).cross(p - b);
+    double d3 = (a - c).cross(p - c);
+    bool hasNeg = d1 < 0 || d2 < 0 || d3 < 0;
+    bool hasPos = d1 > 0 || d2 > 0 || d3 > 0;
+    return !(hasNeg && hasPos);
+}
+
+std::vector<char> PolygonSimplifier::douglasPeucker(const std::vector<PolygonContour>& contours,
+                                                    int contour, double tolerance,
+                                                    const SpatialIndex& edges) {
+    const auto& points = contours[contour].points;
+    int n = static_cast<int>(points.size());
+    std::vector<char> keep(n, 1);
+    if (n <= 3) return keep;
+
+    // Замкнутый контур делится на две цепочки: от вершины 0 до самой далёкой от неё
+    int farthest = 0;
+    double farthestDist = -1;
+    for (int i = 1; i < n; i++) {
+        BoolPoint d = points[i] - points[0];
+        if (d.dot(d) > farthestDist) {
+            farthestDist = d.dot(d);
+            farthest = i;
+        }
+    }
+
+    std::fill(keep.begin(), keep.end(), 0);
+    keep[0] = keep[farthest] = 1;
+
+    // Индекс n обозначает вершину 0 в конце второй цепочки
+    std::vector<std::pair<int, int>> ranges;
+    ranges.push_back(std::make_pair(0, farthest));
+    ranges.push_back(std::make_pair(farthest, n));
+
+    while (!ranges.empty()) {
+        int from = ranges.back().first;
+        int to = ranges.back().second;
+        ranges.pop_back();
+        if (to - from < 2) continue;
+
+        const BoolPoint& a = points[from];
+        const BoolPoint& b = points[to % n];
+        int split = from + 1;
+        double maxDist = -1;
+        for (int i = from + 1; i < to; i++) {
+            double d = segmentDistance(points[i], a, b);
+            if (d > maxDist) {
+                maxDist = d;
+                split = i;
+            }
+        }
+
+        if (maxDist > tolerance || !shortcutAllowed(contours, contour, from, to, edges)) {
+            keep[split] = 1;
+            ranges.push_back(std::make_pair(from, split));
+            ranges.push_back(std::make_pair(split, to));
+        }
+    }
+
+    // Третья вершина — самая далёкая от хорды из тех, чьи новые рёбра допустимы;
+    // если таких нет, контур остаётся как был
+    int kept = static_cast<int>(std::count(keep.begin(), keep.end(), 1));
+    if (kept < 3) {
+        std::vector<std::pair<double, int>> candidates;
+        for (int i = 1; i < n; i++) {
+            if (i == farthest) continue;
+            candidates.push_back(std::make_pair(segmentDistance(points[i], points[0], points[farthest]), i));
+        }
+        std::sort(candidates.begin(), candidates.end(), std::greater<std::pair<double, int>>());
+
+        bool found = false;
+        for (const auto& candidate : candidates) {
+            int i = candidate.second;
+            int from = i < farthest ? 0 : farthest;
+            int to = i < farthest ? farthest : n;
+            if (shortcutAllowed(contours, contour, from, i, edges) &&
+                shortcutAllowed(contours, contour, i, to, edges)) {
+                keep[i] = 1;
+                found = true;
+                break;
+            }
+        }
+        if (!found) std::fill(keep.begin(), keep.end(), 1);
+    }
+    return keep;
+}
+
+std::vector<char> PolygonSimplifier::visvalingam(const std::vector<PolygonContour>& contours,
+                                                 int contour, double tolerance,
+                                                 const SpatialIndex& vertices) {
+    const auto& points = contours[contour].points;
+    int n = static_cast<int>(points.size());
+    std::vector<char> keep(n, 1);
+    if (n <= 3) return keep;
+
+    std::vector<int> prev(n), next(n), version(n, 0);
+    for (int i = 0; i < n; i++) {
+        prev[i] = (i + n - 1) % n;
+        next[i] = (i + 1) % n;
+    }
+
+    auto triangleArea = [&](int i) {
+        return std::abs((points[next[i]] - points[prev[i]]).cross(points[i] - points[prev[i]])) / 2.0;
+    };
+
+    struct HeapEntry {
+        double area;
+        int vertex, version;
+        bool operator>(const HeapEntry& other) const { return area > other.area; }
+    };
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+    std::vector<double> area(n);
+    for (int i = 0; i < n; i++) {
+        area[i] = triangleArea(i);
+        heap.push(HeapEntry{area[i], i, 0});
+    }
+
+    double threshold = tolerance * tolerance;
+    int alive = n;
+    while (!heap.empty() && alive > 3) {
+        HeapEntry top = heap.top();
+        heap.pop();
+        int v = top.vertex;
+        if (!keep[v] || top.version != version[v]) continue;
+        if (top.area >= threshold) break;
+
+        const BoolPoint& a = points[prev[v]];
+        const BoolPoint& b = points[v];
+        const BoolPoint& c = points[next[v]];
+
+        // Вершина удаляется, только если в её треугольнике нет других вершин:
+        // тогда новое ребро не пересечёт ни одно существующее
+        bool blocked = false;
+        int c0, r0, c1, r1;
+        vertices.cellRange(std::min(a.x, std::min(b.x, c.x)), std::min(a.y, std::min(b.y, c.y)),
+                           std::max(a.x, std::max(b.x, c.x)), std::max(a.y, std::max(b.y, c.y)),
+                           c0, r0, c1, r1);
+        for (int r = r0; r <= r1 && !blocked; r++) {
+            for (int col = c0; col <= c1 && !blocked; col++) {
+                for (const auto& ref : vertices.cells[static_cast<size_t>(r) * vertices.columns + col]) {
+                    if (ref.contour == contour &&
+                        (!keep[ref.index] || ref.index == v || ref.index == prev[v] || ref.index == next[v])) {
+                        continue;
+                    }
+                    if (triangleContains(a, b, c, contours[ref.contour].points[ref.index])) {
+                        blocked = true;
+                        break;
+                    }
+                }
+            }
+        }
+        if (blocked) continue;
+
+        keep[v] = 0;
+        alive--;
+        next[prev[v]] = next[v];
+        prev[next[v]] = prev[v];
+
+        int neighbours[2] = {prev[v], next[v]};
+        for (int u : neighbours) {
+            area[u] = std::max(triangleArea(u), top.area);
+            version[u]++;
+            heap.push(HeapEntry{area[u], u, version[u]});
+        }
+    }
+    return keep;
+}
+
+PolygonContour PolygonSimplifier::simplify(const PolygonContour& contour, double tolerance,
+                                           Method method, SimplifyStats* stats) {
+    std::vector<PolygonContour> result =
+        simplify(std::vector<PolygonContour>(1, contour), tolerance, method, stats, 1);
+    return result.front();
+}
+
+std::vector<PolygonContour> PolygonSimplifier::simplify(const std::vector<PolygonContour>& contours,
+                                                        double tolerance, Method method,
+                                                        SimplifyStats* stats, int threads) {
+    // При NaN все сравнения с допуском ложны, и контуры схлопывались бы до трёх вершин
+    if (!(tolerance > 0) || !std::isfinite(tolerance)) {
+        if (stats) {
+            SimplifyStats total;
+            for (const auto& contour : contours) total.inputVertices += contour.points.size();
+            total.outputVertices = total.inputVertices;
+            *stats = total;
+        }
+        return contours;
+    }
+
+    SpatialIndex index;
+    index.build(contours, method == DOUGLAS_PEUCKER);
+
+    std::vector<std::vector<char>> keep(contours.size());
+    std::atomic<size_t> nextContour(0);
+    auto worker = [&]() {
+        for (size_t c = nextContour++; c < contours.size(); c = nextContour++) {
+            int ci = static_cast<int>(c);
+            keep[c] = method == DOUGLAS_PEUCKER
+                ? douglasPeucker(contours, ci, tolerance, index)
+                : visvalingam(contours, ci, tolerance, index);
+        }
+    };
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<int>(threads, static_cast<int>(contours.size()));
+    if (threads <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (auto& thread : pool) thread.join();
+    }
+
+    std::vector<PolygonContour> result(contours.size());
+    SimplifyStats total;
+    for (size_t c = 0; c < contours.size(); c++) {
+        result[c].isHole = contours[c].isHole;
+        for (size_t i = 0; i < contours[c].points.size(); i++) {
+            if (keep[c][i]) result[c].points.push_back(contours[c].points[i]);
+        }
+        total.inputVertices += contours[c].points.size();
+        total.outputVertices += result[c].points.size();
+    }
+    if (stats) *stats = total;
+    return result;
+}
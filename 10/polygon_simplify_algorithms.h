@@ -0,0 +1,73 @@
+#ifndef POLYGON_SIMPLIFY_ALGORITHMS_H
+#define POLYGON_SIMPLIFY_ALGORITHMS_H
+
+#include <vector>
+#include "polygon_bool_algorithms.h"
+
+struct SimplifyStats {
+    size_t inputVertices;
+    size_t outputVertices;
+
+    SimplifyStats() : inputVertices(0), outputVertices(0) {}
+
+    // Во сколько раз уменьшилось число вершин
+    double reductionRatio() const {
+        return outputVertices > 0 ? static_cast<double>(inputVertices) / outputVertices : 0.0;
+    }
+};
+
+// Упрощение контуров перед булевыми операциями. Упрощение не допускает
+// самопересечений и пересечений с другими контурами: новое ребро проверяется
+// по исходным рёбрам и по контурам в отрезаемом им кармане (Дуглас–Пекер),
+// удаляемая вершина — по вершинам внутри её треугольника (Висвалингам).
+// У контура всегда остаётся не меньше трёх вершин.
+class PolygonSimplifier {
+public:
+    enum Method { DOUGLAS_PEUCKER, VISVALINGAM };
+
+    // Для DOUGLAS_PEUCKER tolerance — допустимое отклонение от исходного контура,
+    // для VISVALINGAM удаляются вершины с площадью треугольника меньше tolerance^2.
+    // При tolerance <= 0, бесконечном или NaN контуры возвращаются без изменений.
+    static PolygonContour simplify(const PolygonContour& contour, double tolerance,
+                                   Method method, SimplifyStats* stats = nullptr);
+
+    // threads = 0 — по числу аппаратных потоков, контуры делятся между потоками
+    static std::vector<PolygonContour> simplify(const std::vector<PolygonContour>& contours,
+                                                double tolerance, Method method,
+                                                SimplifyStats* stats = nullptr, int threads = 1);
+
+private:
+    struct ItemRef {
+        int contour, index;
+        ItemRef(int contour = 0, int index = 0) : contour(contour), index(index) {}
+    };
+
+    // Равномерная сетка по рёбрам или вершинам всех контуров
+    struct SpatialIndex {
+        double minX, minY, cellSize;
+        int columns, rows;
+        std::vector<std::vector<ItemRef>> cells;
+
+        void build(const std::vector<PolygonContour>& contours, bool edges);
+        void cellRange(double x0, double y0, double x1, double y1,
+                       int& c0, int& r0, int& c1, int& r1) const;
+    };
+
+    static std::vector<char> douglasPeucker(const std::vector<PolygonContour>& contours,
+                                            int contour, double tolerance,
+                                            const SpatialIndex& edges);
+    static std::vector<char> visvalingam(const std::vector<PolygonContour>& contours,
+                                         int contour, double tolerance,
+                                         const SpatialIndex& vertices);
+
+    static bool shortcutCrosses(const std::vector<PolygonContour>& contours, int contour,
+                                int from, int to, const SpatialIndex& edges);
+    static bool pocketHoldsContour(const std::vector<PolygonContour>& contours, int contour,
+                                   int from, int to, const SpatialIndex& edges);
+    static bool shortcutAllowed(const std::vector<PolygonContour>& contours, int contour,
+                                int from, int to, const SpatialIndex& edges);
+    static bool triangleContains(const BoolPoint& a, const BoolPoint& b, const BoolPoint& c,
+                                 const BoolPoint& p);
+};
+
+#endif
@@ -0,0 +1,344 @@
+#include "polygon_triangulation_algorithms.h"
+#include <algorithm>
+#include <set>
+
+static double signedArea(const std::vector<BoolPoint>& points) {
+    double area = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        size_t j = (i + 1) % points.size();
+        area += points[i].x * points[j].y - points[j].x * points[i].y;
+    }
+    return area / 2.0;
+}
+
+bool PolygonTriangulator::above(const Sweep& s, int a, int b) {
+    const BoolPoint& p = s.points[a];
+    const BoolPoint& q = s.points[b];
+    if (p.y != q.y) return p.y > q.y;
+    if (p.x != q.x) return p.x < q.x;
+    return a < b;
+}
+
+double PolygonTriangulator::edgeXAt(const Sweep& s, int edge) {
+    const BoolPoint& a = s.points[edge];
+    const BoolPoint& b = s.points[s.next[edge]];
+    if (a.y == b.y) {
+        return std::max(std::min(a.x, b.x), std::min(std::max(a.x, b.x), s.sweepX));
+    }
+    return a.x + (s.sweepY - a.y) * (b.x - a.x) / (b.y - a.y);
+}
+
+PolygonTriangulator::VertexType PolygonTriangulator::vertexType(const Sweep& s, int v) {
+    int p = s.prev[v];
+    int n = s.next[v];
+    BoolPoint in = s.points[v] - s.points[p];
+    BoolPoint out = s.points[n] - s.points[v];
+    bool convex = in.cross(out) > 0;
+
+    if (above(s, v, p) && above(s, v, n)) return convex ? START : SPLIT;
+    if (above(s, p, v) && above(s, n, v)) return convex ? END : MERGE;
+    return REGULAR;
+}
+
+std::vector<std::pair<int, int>> PolygonTriangulator::monotoneDiagonals(Sweep& s) {
+    int n = static_cast<int>(s.points.size());
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&s](int a, int b) { return above(s, a, b); });
+
+    // Ключ -1 — текущая точка события, используется для поиска ребра слева от неё
+    auto less = [&s](int a, int b) {
+        double xa = a < 0 ? s.sweepX : edgeXAt(s, a);
+        double xb = b < 0 ? s.sweepX : edgeXAt(s, b);
+        if (xa != xb) return xa < xb;
+        if (a < 0 || b < 0) return a < 0 && b >= 0;
+        return a < b;
+    };
+    std::set<int, decltype(less)> status(less);
+    std::vector<std::set<int, decltype(less)>::iterator> position(n, status.end());
+    std::vector<int> helper(n, -1);
+    std::vector<VertexType> types(n);
+    std::vector<std::pair<int, int>> diagonals;
+
+    auto insertEdge = [&](int e, int v) {
+        position[e] = status.insert(e).first;
+        helper[e] = v;
+    };
+    auto removeEdge = [&](int e) {
+        if (position[e] != status.end()) {
+            status.erase(position[e]);
+            position[e] = status.end();
+        }
+    };
+    auto edgeLeftOf = [&]() {
+        auto it = status.lower_bound(-1);
+        if (it == status.begin()) return -1;
+        return *std::prev(it);
+    };
+    auto fixHelper = [&](int e, int v) {
+        if (e >= 0 && helper[e] >= 0 && types[helper[e]] == MERGE) {
+            diagonals.emplace_back(v, helper[e]);
+        }
+    };
+
+    for (int v : order) {
+        s.sweepX = s.points[v].x;
+        s.sweepY = s.points[v].y;
+        types[v] = vertexType(s, v);
+        int prevEdge = s.prev[v];
+
+        switch (types[v]) {
+        case START:
+            insertEdge(v, v);
+            break;
+        case END:
+            fixHelper(prevEdge, v);
+            removeEdge(prevEdge);
+            break;
+        case SPLIT: {
+            int left = edgeLeftOf();
+            if (left >= 0) {
+                diagonals.emplace_back(v, helper[left]);
+                helper[left] = v;
+            }
+            insertEdge(v, v);
+            break;
+        }
+        case MERGE: {
+            fixHelper(prevEdge, v);
+            removeEdge(prevEdge);
+            int left = edgeLeftOf();
+            if (left >= 0) {
+                fixHelper(left, v);
+                helper[left] = v;
+            }
+            break;
+        }
+        case REGULAR:
+            if (above(s, s.prev[v], v)) {
+                fixHelper(prevEdge, v);
+                removeEdge(prevEdge);
+                insertEdge(v, v);
+            } else {
+                int left = edgeLeftOf();
+                if (left >= 0) {
+                    fixHelper(left, v);
+                    helper[left] = v;
+                }
+            }
+            break;
+        }
+    }
+
+    return diagonals;
+}
+
+std::vector<std::vector<int>> PolygonTriangulator::monotoneFaces(
+    const Sweep& s, const std::vector<std::pair<int, int>>& diagonals) {
+
+    int n = static_cast<int>(s.points.size());
+    std::vector<std::vector<int>> out(n);
+    for (int v = 0; v < n; v++) out[v].push_back(s.next[v]);
+    for (const auto& d : diagonals) {
+        out[d.first].push_back(d.second);
+        out[d.second].push_back(d.first);
+    }
+
+    auto angle = [&s](int from, int to) {
+        return std::atan2(s.points[to].y - s.points[from].y, s.points[to].x - s.points[from].x);
+    };
+
+    std::vector<std::vector<double>> angles(n);
+    std::vector<std::vector<char>> visited(n);
+    for (int v = 0; v < n; v++) {
+        std::sort(out[v].begin(), out[v].end(),
+                  [&](int a, int b) { return angle(v, a) < angle(v, b); });
+        for (int w : out[v]) angles[v].push_back(angle(v, w));
+        visited[v].assign(out[v].size(), 0);
+    }
+
+    size_t halfEdges = n + 2 * diagonals.size();
+    std::vector<std::vector<int>> faces;
+
+    for (int start = 0; start < n; start++) {
+        for (size_t k = 0; k < out[start].size(); k++) {
+            if (visited[start][k]) continue;
+
+            std::vector<int> face;
+            int u = start;
+            size_t slot = k;
+            while (!visited[u][slot] && face.size() <= halfEdges) {
+                visited[u][slot] = 1;
+                face.push_back(u);
+
+                int v = out[u][slot];
+                // Следующее ребро — первое по часовой стрелке от направления v -> u
+                double back = angle(v, u);
+                auto it = std::lower_bound(angles[v].begin(), angles[v].end(), back);
+                size_t next = it == angles[v].begin() ? angles[v].size() - 1 : (it - angles[v].begin()) - 1;
+                u = v;
+                slot = next;
+            }
+            if (face.size() >= 3) faces.push_back(face);
+        }
+    }
+
+    return faces;
+}
+
+void PolygonTriangulator::emitTriangle(const Sweep& s, int a, int b, int c, std::vector<int>& indices) {
+    double cross = (s.points[b] - s.points[a]).cross(s.points[c] - s.points[a]);
+    if (cross == 0) return;
+    if (cross < 0) std::swap(b, c);
+    indices.push_back(a);
+    indices.push_back(b);
+    indices.push_back(c);
+}
+
+void PolygonTriangulator::triangulateMonotone(const Sweep& s, const std::vector<int>& face,
+                                              std::vector<int>& indices) {
+    size_t k = face.size();
+    if (k == 3) {
+        emitTriangle(s, face[0], face[1], face[2], indices);
+        return;
+    }
+
+    size_t top = 0, bottom = 0;
+    for (size_t i = 1; i < k; i++) {
+        if (above(s, face[i], face[top])) top = i;
+        if (above(s, face[bottom], face[i])) bottom = i;
+    }
+
+    // Обход против часовой стрелки от верхней вершины идёт по левой цепи
+    std::vector<char> leftChain(s.points.size(), 0);
+    for (size_t i = top; i != bottom; i = (i + 1) % k) leftChain[face[i]] = 1;
+
+    std::vector<int> sorted = face;
+    std::sort(sorted.begin(), sorted.end(), [&s](int a, int b) { return above(s, a, b); });
+
+    std::vector<int> stack;
+    stack.push_back(sorted[0]);
+    stack.push_back(sorted[1]);
+
+    for (size_t j = 2; j + 1 < k; j++) {
+        int u = sorted[j];
+        if (leftChain[u] != leftChain[stack.back()]) {
+            while (stack.size() > 1) {
+                int a = stack.back();
+                stack.pop_back();
+                emitTriangle(s, u, a, stack.back(), indices);
+            }
+            stack.clear();
+            stack.push_back(sorted[j - 1]);
+            stack.push_back(u);
+        } else {
+            int last = stack.back();
+            stack.pop_back();
+            while (!stack.empty()) {
+                int t = stack.back();
+                double cross = leftChain[u]
+                    ? (s.points[last] - s.points[t]).cross(s.points[u] - s.points[t])
+                    : (s.points[last] - s.points[u]).cross(s.points[t] - s.points[u]);
+                if (cross <= 0) break;
+                emitTriangle(s, u, last, t, indices);
+                last = t;
+                stack.pop_back();
+            }
+            stack.push_back(last);
+            stack.push_back(u);
+        }
+    }
+
+    int u = sorted[k - 1];
+    while (stack.size() > 1) {
+        int a = stack.back();
+        stack.pop_back();
+        emitTriangle(s, u, a, stack.back(), indices);
+    }
+}
+
+TriangleMesh PolygonTriangulator::triangulate(const std::vector<PolygonContour>& contours) {
+    TriangleMesh mesh;
+
+    std::vector<std::vector<BoolPoint>> rings;
+    for (const auto& contour : contours) {
+        std::vector<BoolPoint> ring;
+        for (const auto& p : contour.points) {
+            if (ring.empty() || ring.back().x != p.x || ring.back().y != p.y) ring.push_back(p);
+        }
+        while (ring.size() > 1 && ring.back().x == ring.front().x && ring.back().y == ring.front().y) {
+            ring.pop_back();
+        }
+        if (ring.size() >= 3 && signedArea(ring) != 0) rings.push_back(ring);
+    }
+
+    std::vector<PolygonContour> ringContours(rings.size());
+    for (size_t r = 0; r < rings.size(); r++) ringContours[r].points = rings[r];
+    PolygonBoolean::classifyHoles(ringContours);
+
+    Sweep s;
+    for (size_t r = 0; r < rings.size(); r++) {
+        std::vector<BoolPoint>& ring = rings[r];
+        bool counterClockwise = signedArea(ring) > 0;
+        if (counterClockwise == ringContours[r].isHole) std::reverse(ring.begin(), ring.end());
+
+        int base = static_cast<int>(s.points.size());
+        int size = static_cast<int>(ring.size());
+        for (int i = 0; i < size; i++) {
+            s.points.push_back(ring[i]);
+            s.prev.push_back(base + (i + size - 1) % size);
+            s.next.push_back(base + (i + 1) % size);
+        }
+    }
+
+    if (s.points.empty()) return mesh;
+
+    std::vector<std::pair<int, int>> diagonals = monotoneDiagonals(s);
+    for (const auto& face : monotoneFaces(s, diagonals)) {
+        triangulateMonotone(s, face, mesh.indices);
+    }
+
+    mesh.vertices = s.points;
+    return mesh;
+}
+
+TriangleMesh PolygonTriangulator::triangulateEach(const std::vector<PolygonContour>& contours) {
+    TriangleMesh mesh;
+    for (const auto& contour : contours) {
+        TriangleMesh part = triangulate(std::vector<PolygonContour>(1, contour));
+        int base = static_cast<int>(mesh.vertices.size());
+        mesh.vertices.insert(mesh.vertices.end(), part.vertices.begin(), part.vertices.end());
+        for (int index : part.indices) mesh.indices.push_back(base + index);
+    }
+    return mesh;
+}
+
+double PolygonTriangulator::meshArea(const TriangleMesh& mesh) {
+    double area = 0;
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const BoolPoint& a = mesh.vertices[mesh.indices[t]];
+        const BoolPoint& b = mesh.vertices[mesh.indices[t + 1]];
+        const BoolPoint& c = mesh.vertices[mesh.indices[t + 2]];
+        area += (b - a).cross(c - a) / 2.0;
+    }
+    return area;
+}
+
+BoolPoint PolygonTriangulator::meshCentroid(const TriangleMesh& mesh) {
+    double area = 0;
+    BoolPoint centroid(0, 0);
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const BoolPoint& a = mesh.vertices[mesh.indices[t]];
+        const BoolPoint& b = mesh.vertices[mesh.indices[t + 1]];
+        const BoolPoint& c = mesh.vertices[mesh.indices[t + 2]];
+        double w = (b - a).cross(c - a) / 2.0;
+        area += w;
+        centroid.x += w * (a.x + b.x + c.x) / 3.0;
+        centroid.y += w * (a.y + b.y + c.y) / 3.0;
+    }
+    if (area != 0) {
+        centroid.x /= area;
+        centroid.y /= area;
+    }
+    return centroid;
+}
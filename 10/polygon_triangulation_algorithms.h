@@ -0,0 +1,50 @@
+#ifndef POLYGON_TRIANGULATION_ALGORITHMS_H
+#define POLYGON_TRIANGULATION_ALGORITHMS_H
+
+#include <vector>
+#include "polygon_bool_algorithms.h"
+
+struct TriangleMesh {
+    std::vector<BoolPoint> vertices;
+    std::vector<int> indices;   // по три индекса на треугольник, обход против часовой стрелки
+
+    size_t triangleCount() const { return indices.size() / 3; }
+    void clear() {
+        vertices.clear();
+        indices.clear();
+    }
+};
+
+// Триангуляция за O(n log n): разбиение на y-монотонные части заметающей
+// прямой с последующей триангуляцией каждой монотонной части стеком.
+// Контуры с чётной глубиной вложенности считаются внешними, с нечётной — дырами.
+class PolygonTriangulator {
+public:
+    static TriangleMesh triangulate(const std::vector<PolygonContour>& contours);
+    // Каждый контур триангулируется отдельно — для перекрывающихся контуров,
+    // которые возвращает booleanOperation
+    static TriangleMesh triangulateEach(const std::vector<PolygonContour>& contours);
+
+    static double meshArea(const TriangleMesh& mesh);
+    static BoolPoint meshCentroid(const TriangleMesh& mesh);
+
+private:
+    enum VertexType { START, SPLIT, END, MERGE, REGULAR };
+
+    struct Sweep {
+        std::vector<BoolPoint> points;
+        std::vector<int> prev, next;
+        double sweepX, sweepY;
+    };
+
+    static bool above(const Sweep& s, int a, int b);
+    static double edgeXAt(const Sweep& s, int edge);
+    static VertexType vertexType(const Sweep& s, int v);
+    static std::vector<std::pair<int, int>> monotoneDiagonals(Sweep& s);
+    static std::vector<std::vector<int>> monotoneFaces(const Sweep& s,
+                                                       const std::vector<std::pair<int, int>>& diagonals);
+    static void triangulateMonotone(const Sweep& s, const std::vector<int>& face, std::vector<int>& indices);
+    static void emitTriangle(const Sweep& s, int a, int b, int c, std::vector<int>& indices);
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "distance_field_algorithms.h"
+#include <atomic>
+#include <thread>
+
+static const double kFar = 1e20;
+
+static double segmentDistance2(const AlgoPoint2D& p, const AlgoPoint2D& a, const AlgoPoint2D& b) {
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double rx = p.x - a.x, ry = p.y - a.y;
+    double l2 = dx * dx + dy * dy;
+    double t = l2 > 0 ? std::max(0.0, std::min(1.0, (rx * dx + ry * dy) / l2)) : 0.0;
+    double ex = rx - t * dx, ey = ry - t * dy;
+    return ex * ex + ey * ey;
+}
+
+double DistanceField::sample(const AlgoPoint2D& point) const {
+    if (values.empty()) return std::numeric_limits<double>::max();
+
+    double fx = (point.x - originX) / cellSize;
+    double fy = (point.y - originY) / cellSize;
+    double cx = std::max(0.0, std::min<double>(width - 1, fx));
+    double cy = std::max(0.0, std::min<double>(height - 1, fy));
+    double outside = std::hypot(fx - cx, fy - cy) * cellSize;
+
+    size_t i = std::min(static_cast<size_t>(cx), width - 2);
+    size_t j = std::min(static_cast<size_t>(cy), height - 2);
+    double tx = cx - i, ty = cy - j;
+    const float* row = values.data() + j * width + i;
+    double bottom = row[0] + (row[1] - row[0]) * tx;
+    double top = row[width] + (row[width + 1] - row[width]) * tx;
+    return bottom + (top - bottom) * ty + outside;
+}
+
+// Нижняя огибающая парабол (q - p)^2 + f(p): d(q) — её значение в q, nearest[q] — вершина p
+void DistanceFieldAlgorithms::transform(const double* f, size_t n, double* d, size_t* nearest, size_t* v,
+                                        double* z) {
+    size_t k = 0;
+    v[0] = 0;
+    z[0] = -kFar;
+    z[1] = kFar;
+    auto intersection = [&](size_t q, size_t p) {
+        return ((f[q] + double(q) * q) - (f[p] + double(p) * p)) / (2.0 * q - 2.0 * p);
+    };
+    for (size_t q = 1; q < n; q++) {
+        double s = intersection(q, v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = intersection(q, v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = kFar;
+    }
+
+    k = 0;
+    for (size_t q = 0; q < n; q++) {
+        while (z[k + 1] < q) k++;
+        double dq = static_cast<double>(q) - v[k];
+        d[q] = dq * dq + f[v[k]];
+        nearest[q] = v[k];
+    }
+}
+
+// Блоки индексов раздаются потокам через общий счётчик
+template <typename Task>
+void DistanceFieldAlgorithms::parallelFor(size_t count, int threads, Task task) {
+    const size_t blockSize = 16;
+    std::atomic<size_t> nextBlock(0);
+    auto worker = [&]() {
+        for (size_t begin = nextBlock.fetch_add(blockSize); begin < count; begin = nextBlock.fetch_add(blockSize)) {
+            task(begin, std::min(count, begin + blockSize));
+        }
+    };
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocks = (count + blockSize - 1) / blockSize;
+    threads = static_cast<int>(std::min<size_t>(threads, blocks));
+    if (threads <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (auto& thread : pool) thread.join();
+    }
+}
+
+DistanceField DistanceFieldAlgorithms::build(const std::vector<AlgoPoint2D>& polygon, size_t width, size_t height,
+                                             double padding, int threads) {
+    return build(std::vector<std::vector<AlgoPoint2D>>{polygon}, width, height, padding, threads);
+}
+
+DistanceField DistanceFieldAlgorithms::build(const std::vector<std::vector<AlgoPoint2D>>& contours, size_t width,
+                                             size_t height, double padding, int threads) {
+    struct Segment {
+        AlgoPoint2D a, b;
+    };
+    std::vector<Segment> segments;
+    for (const auto& contour : contours) {
+        if (contour.size() < 3) continue;
+        for (size_t i = 0, j = contour.size() - 1; i < contour.size(); j = i++) {
+            segments.push_back({contour[i], contour[j]});
+        }
+    }
+
+    DistanceField field;
+    if (segments.empty() || width < 2 || height < 2) return field;
+
+    double minX = segments[0].a.x, maxX = minX, minY = segments[0].a.y, maxY = minY;
+    for (const auto& s : segments) {
+        minX = std::min(minX, s.a.x);
+        maxX = std::max(maxX, s.a.x);
+        minY = std::min(minY, s.a.y);
+        maxY = std::max(maxY, s.a.y);
+    }
+    field.width = width;
+    field.height = height;
+    field.cellSize = std::max((maxX - minX + 2 * padding) / (width - 1), (maxY - minY + 2 * padding) / (height - 1));
+    if (!(field.cellSize > 0)) field.cellSize = 1;
+    field.originX = (minX + maxX) / 2 - field.cellSize * (width - 1) / 2;
+    field.originY = (minY + maxY) / 2 - field.cellSize * (height - 1) / 2;
+
+    // Точные квадраты расстояний (в клетках) для узлов не дальше клетки от рёбер
+    // и ближайшее к узлу ребро
+    std::vector<double> band(width * height, kFar);
+    std::vector<unsigned> bandSegment(width * height, 0);
+    auto toGrid = [&](const AlgoPoint2D& p) {
+        return AlgoPoint2D((p.x - field.originX) / field.cellSize, (p.y - field.originY) / field.cellSize);
+    };
+    auto clampIndex = [](double value, size_t count) {
+        if (value < 0) return size_t(0);
+        return std::min(count - 1, static_cast<size_t>(value));
+    };
+    for (unsigned k = 0; k < segments.size(); k++) {
+        AlgoPoint2D a = toGrid(segments[k].a), b = toGrid(segments[k].b);
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double l2 = dx * dx + dy * dy;
+        size_t firstRow = clampIndex(std::ceil(std::min(a.y, b.y) - 1), height);
+        size_t lastRow = clampIndex(std::floor(std::max(a.y, b.y) + 1), height);
+        for (size_t j = firstRow; j <= lastRow; j++) {
+            double t0 = 0, t1 = 1;
+            if (dy != 0) {
+                t0 = (j - 1.0 - a.y) / dy;
+                t1 = (j + 1.0 - a.y) / dy;
+                if (t0 > t1) std::swap(t0, t1);
+                t0 = std::max(0.0, t0);
+                t1 = std::min(1.0, t1);
+                if (t0 > t1) continue;
+            }
+            double x0 = std::min(a.x + t0 * dx, a.x + t1 * dx);
+            double x1 = std::max(a.x + t0 * dx, a.x + t1 * dx);
+            size_t firstColumn = clampIndex(std::ceil(x0 - 1), width);
+            size_t lastColumn = clampIndex(std::floor(x1 + 1), width);
+            for (size_t i = firstColumn; i <= lastColumn; i++) {
+                double rx = i - a.x, ry = j - a.y;
+                double t = l2 > 0 ? std::max(0.0, std::min(1.0, (rx * dx + ry * dy) / l2)) : 0.0;
+                double ex = rx - t * dx, ey = ry - t * dy;
+                double d2 = ex * ex + ey * ey;
+                if (d2 <= 1.0 && d2 < band[j * width + i]) {
+                    band[j * width + i] = d2;
+                    bandSegment[j * width + i] = k;
+                }
+            }
+        }
+    }
+
+    // Проход по столбцам запоминает строку ближайшего узла полосы, по строкам — столбец
+    std::vector<double> distance2(width * height);
+    std::vector<size_t> nearestRow(width * height);
+    parallelFor(width, threads, [&](size_t begin, size_t end) {
+        std::vector<double> f(height), d(height), z(height + 1);
+        std::vector<size_t> nearest(height), v(height);
+        for (size_t i = begin; i < end; i++) {
+            for (size_t j = 0; j < height; j++) f[j] = band[j * width + i];
+            transform(f.data(), height, d.data(), nearest.data(), v.data(), z.data());
+            for (size_t j = 0; j < height; j++) {
+                distance2[j * width + i] = d[j];
+                nearestRow[j * width + i] = nearest[j];
+            }
+        }
+    });
+
+    // Рёбра раскладываются по строкам узлов, которые они пересекают
+    std::vector<std::vector<unsigned>> rowSegments(height);
+    for (unsigned k = 0; k < segments.size(); k++) {
+        double low = (std::min(segments[k].a.y, segments[k].b.y) - field.originY) / field.cellSize;
+        double high = (std::max(segments[k].a.y, segments[k].b.y) - field.originY) / field.cellSize;
+        for (size_t j = clampIndex(low - 1, height); j <= clampIndex(high + 1, height); j++) {
+            rowSegments[j].push_back(k);
+        }
+    }
+
+    field.values.resize(width * height);
+    parallelFor(height, threads, [&](size_t begin, size_t end) {
+        std::vector<double> f(width), d(width), z(width + 1), crossings;
+        std::vector<size_t> nearest(width), v(width);
+        for (size_t j = begin; j < end; j++) {
+            std::copy(distance2.begin() + j * width, distance2.begin() + (j + 1) * width, f.begin());
+            transform(f.data(), width, d.data(), nearest.data(), v.data(), z.data());
+
+            double y = field.originY + j * field.cellSize;
+            crossings.clear();
+            for (unsigned k : rowSegments[j]) {
+                const AlgoPoint2D& a = segments[k].a;
+                const AlgoPoint2D& b = segments[k].b;
+                if ((a.y > y) != (b.y > y)) crossings.push_back((b.x - a.x) * (y - a.y) / (b.y - a.y) + a.x);
+            }
+            std::sort(crossings.begin(), crossings.end());
+
+            size_t right = crossings.size();
+            bool inside = false;
+            for (size_t i = width; i-- > 0;) {
+                double x = field.originX + i * field.cellSize;
+                while (right > 0 && crossings[right - 1] > x) {
+                    right--;
+                    inside = !inside;
+                }
+                // Расстояние до ребра ближайшего узла полосы точнее, чем сумма
+                // квадратов из преобразования, и не меньше истинного
+                size_t seed = nearestRow[j * width + nearest[i]] * width + nearest[i];
+                const Segment& s = segments[bandSegment[seed]];
+                double dist = d[i] < kFar ? std::sqrt(segmentDistance2(AlgoPoint2D(x, y), s.a, s.b)) : kFar;
+                field.values[j * width + i] = static_cast<float>(inside ? -dist : dist);
+            }
+        }
+    });
+    return field;
+}
@@ -0,0 +1,41 @@
+#ifndef DISTANCE_FIELD_ALGORITHMS_H
+#define DISTANCE_FIELD_ALGORITHMS_H
+
+#include <vector>
+#include "point_in_hull_algorithms.h"
+
+// Растр знакового расстояния до границы: узел (i, j) лежит в точке
+// (originX + i * cellSize, originY + j * cellSize), внутри значения отрицательные
+struct DistanceField {
+    size_t width, height;
+    double originX, originY, cellSize;
+    std::vector<float> values;
+
+    DistanceField() : width(0), height(0), originX(0), originY(0), cellSize(1) {}
+
+    // Билинейная интерполяция; за пределами растра к значению на краю
+    // добавляется расстояние до него
+    double sample(const AlgoPoint2D& point) const;
+    bool contains(const AlgoPoint2D& point) const { return sample(point) < 0; }
+};
+
+// Узлы не дальше клетки от границы запоминают ближайшее ребро. Точное евклидово
+// преобразование расстояний Фельценшвальба — Хуттенлохера (проход по столбцам,
+// затем по строкам) находит для каждого узла ближайший узел этой полосы, и
+// значение — расстояние до его ребра. Знак даёт заливка строк по чётности
+// пересечений. Столбцы и строки делятся между потоками.
+class DistanceFieldAlgorithms {
+public:
+    // Растр width x height узлов с квадратными клетками над габаритом, расширенным на padding
+    static DistanceField build(const std::vector<AlgoPoint2D>& polygon, size_t width, size_t height,
+                               double padding = 0, int threads = 0);
+    static DistanceField build(const std::vector<std::vector<AlgoPoint2D>>& contours, size_t width, size_t height,
+                               double padding = 0, int threads = 0);
+
+private:
+    static void transform(const double* f, size_t n, double* d, size_t* nearest, size_t* v, double* z);
+    template <typename Task>
+    static void parallelFor(size_t count, int threads, Task task);
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include "edge_index_algorithms.h"
+
+EdgeIndex::EdgeIndex(const std::vector<AlgoPoint2D>& polygon) : points(polygon) {
+    if (points.size() < 2) return;
+
+    order.resize(points.size());
+    for (unsigned i = 0; i < order.size(); i++) order[i] = i;
+    nodes.reserve(2 * order.size() / 4 + 1);
+    build(0, static_cast<unsigned>(order.size()));
+}
+
+unsigned EdgeIndex::build(unsigned first, unsigned count) {
+    const size_t leafSize = 4;
+    unsigned index = static_cast<unsigned>(nodes.size());
+    nodes.push_back(Node());
+
+    Node node;
+    node.minX = node.minY = std::numeric_limits<double>::max();
+    node.maxX = node.maxY = -std::numeric_limits<double>::max();
+    for (unsigned k = first; k < first + count; k++) {
+        const AlgoPoint2D& a = points[order[k]];
+        const AlgoPoint2D& b = points[(order[k] + 1) % points.size()];
+        node.minX = std::min(node.minX, std::min(a.x, b.x));
+        node.minY = std::min(node.minY, std::min(a.y, b.y));
+        node.maxX = std::max(node.maxX, std::max(a.x, b.x));
+        node.maxY = std::max(node.maxY, std::max(a.y, b.y));
+    }
+    node.first = first;
+    node.count = count;
+    node.right = 0;
+
+    if (count > leafSize) {
+        // Деление по медиане середин рёбер вдоль длинной стороны
+        bool alongX = node.maxX - node.minX >= node.maxY - node.minY;
+        auto middle = [&](unsigned edge) {
+            const AlgoPoint2D& a = points[edge];
+            const AlgoPoint2D& b = points[(edge + 1) % points.size()];
+            return alongX ? a.x + b.x : a.y + b.y;
+        };
+        unsigned half = count / 2;
+        std::nth_element(order.begin() + first, order.begin() + first + half, order.begin() + first + count,
+                         [&](unsigned a, unsigned b) { return middle(a) < middle(b); });
+        node.count = 0;
+        build(first, half);
+        node.right = build(first + half, count - half);
+    }
+    nodes[index] = node;
+    return index;
+}
+
+double EdgeIndex::edgeDistance2(size_t edge, const AlgoPoint2D& point) const {
+    const AlgoPoint2D& a = points[edge];
+    const AlgoPoint2D& b = points[(edge + 1) % points.size()];
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double rx = point.x - a.x, ry = point.y - a.y;
+    double l2 = dx * dx + dy * dy;
+    double t = l2 > 0 ? std::max(0.0, std::min(1.0, (rx * dx + ry * dy) / l2)) : 0.0;
+    double ex = rx - t * dx, ey = ry - t * dy;
+    return ex * ex + ey * ey;
+}
+
+double EdgeIndex::boxDistance2(const Node& node, const AlgoPoint2D& point) {
+    double dx = std::max(0.0, std::max(node.minX - point.x, point.x - node.maxX));
+    double dy = std::max(0.0, std::max(node.minY - point.y, point.y - node.maxY));
+    return dx * dx + dy * dy;
+}
+
+size_t EdgeIndex::nearestEdge(const AlgoPoint2D& point, double* distance2) const {
+    size_t best = kNoEdge;
+    double bestDist2 = std::numeric_limits<double>::max();
+    if (nodes.empty()) return best;
+
+    unsigned stack[64];
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        if (boxDistance2(node, point) >= bestDist2) continue;
+
+        if (node.count > 0) {
+            for (unsigned k = node.first; k < node.first + node.count; k++) {
+                double d = edgeDistance2(order[k], point);
+                if (d < bestDist2) {
+                    bestDist2 = d;
+                    best = order[k];
+                }
+            }
+            continue;
+        }
+
+        // Ближний потомок кладётся последним и обходится первым
+        unsigned left = static_cast<unsigned>(&node - nodes.data()) + 1;
+        unsigned right = node.right;
+        if (boxDistance2(nodes[left], point) < boxDistance2(nodes[right], point)) std::swap(left, right);
+        stack[top++] = left;
+        stack[top++] = right;
+    }
+    if (distance2) *distance2 = bestDist2;
+    return best;
+}
+
+std::vector<size_t> EdgeIndex::edgesWithin(const AlgoPoint2D& point, double radius) const {
+    std::vector<size_t> result;
+    if (nodes.empty()) return result;
+
+    double radius2 = radius * radius;
+    unsigned stack[64];
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        if (boxDistance2(node, point) > radius2) continue;
+
+        if (node.count > 0) {
+            for (unsigned k = node.first; k < node.first + node.count; k++) {
+                if (edgeDistance2(order[k], point) <= radius2) result.push_back(order[k]);
+            }
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = index + 1;
+        }
+    }
+    return result;
+}
+
+bool EdgeIndex::anyWithin(const AlgoPoint2D& point, double radius) const {
+    if (nodes.empty()) return false;
+
+    double radius2 = radius * radius;
+    unsigned stack[64];
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        if (boxDistance2(node, point) >= radius2) continue;
+
+        if (node.count > 0) {
+            for (unsigned k = node.first; k < node.first + node.count; k++) {
+                if (edgeDistance2(order[k], point) < radius2) return true;
+            }
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = index + 1;
+        }
+    }
+    return false;
+}
+
+// Обходятся только узлы, прямоугольник которых задевает луч y = point.y, x > point.x
+bool EdgeIndex::oddCrossings(const AlgoPoint2D& point) const {
+    bool inside = false;
+    if (nodes.empty()) return inside;
+
+    unsigned stack[64];
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        if (point.y < node.minY || point.y > node.maxY || point.x >= node.maxX) continue;
+
+        if (node.count > 0) {
+            for (unsigned k = node.first; k < node.first + node.count; k++) {
+                const AlgoPoint2D& a = points[order[k]];
+                const AlgoPoint2D& b = points[(order[k] + 1) % points.size()];
+                if (((a.y > point.y) != (b.y > point.y)) &&
+                    (point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x)) {
+                    inside = !inside;
+                }
+            }
+        } else {
+            stack[top++] = node.right;
+            stack[top++] = index + 1;
+        }
+    }
+    return inside;
+}
@@ -0,0 +1,47 @@
+#ifndef EDGE_INDEX_ALGORITHMS_H
+#define EDGE_INDEX_ALGORITHMS_H
+
+#include <vector>
+#include "point_in_hull_algorithms.h"
+
+// Иерархия ограничивающих прямоугольников над рёбрами многоугольника; ребро i
+// соединяет вершины i и i + 1. Строится делением по медиане за O(n log n),
+// ближайшее ребро ищется ветвями и границами по квадратам расстояний до
+// прямоугольников и отрезков, без корней.
+class EdgeIndex {
+public:
+    static constexpr size_t kNoEdge = static_cast<size_t>(-1);
+
+    explicit EdgeIndex(const std::vector<AlgoPoint2D>& polygon = {});
+
+    // Ближайшее ребро (kNoEdge для пустого индекса) и квадрат расстояния до него
+    size_t nearestEdge(const AlgoPoint2D& point, double* distance2 = nullptr) const;
+    // Рёбра на расстоянии не больше radius
+    std::vector<size_t> edgesWithin(const AlgoPoint2D& point, double radius) const;
+
+    // Есть ли ребро строго ближе radius; поиск останавливается на первом
+    bool anyWithin(const AlgoPoint2D& point, double radius) const;
+    // Чётность числа рёбер, пересекаемых лучом из точки вправо (правило check)
+    bool oddCrossings(const AlgoPoint2D& point) const;
+
+    const std::vector<AlgoPoint2D>& polygon() const { return points; }
+    size_t size() const { return order.size(); }
+
+private:
+    // Лист хранит count рёбер начиная с first в order; у внутреннего узла левый
+    // потомок идёт следом, правый — по индексу right
+    struct Node {
+        double minX, minY, maxX, maxY;
+        unsigned first, count, right;
+    };
+
+    unsigned build(unsigned first, unsigned count);
+    double edgeDistance2(size_t edge, const AlgoPoint2D& point) const;
+    static double boxDistance2(const Node& node, const AlgoPoint2D& point);
+
+    std::vector<AlgoPoint2D> points;
+    std::vector<unsigned> order;
+    std::vector<Node> nodes;
+};
+
+#endif
@@ -1,4 +1,22 @@
 #include "point_in_hull_algorithms.h"
+#include "edge_index_algorithms.h"
+#include <atomic>
+#include <thread>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+static double orient(const AlgoPoint2D& a, const AlgoPoint2D& b, const AlgoPoint2D& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static double segmentDistance2(const AlgoPoint2D& p, const AlgoPoint2D& a, const AlgoPoint2D& b) {
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double l2 = dx * dx + dy * dy;
+    double t = l2 > 0 ? std::max(0.0, std::min(1.0, ((p.x - a.x) * dx + (p.y - a.y) * dy) / l2)) : 0.0;
+    double ex = a.x + t * dx - p.x, ey = a.y + t * dy - p.y;
+    return ex * ex + ey * ey;
+}
 
 double PointInPolygonAlgorithms::cross(const AlgoPoint2D& a, const AlgoPoint2D& b, const AlgoPoint2D& c) {
     return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
@@ -27,7 +45,7 @@ int PointInPolygonAlgorithms::check(const AlgoPoint2D& point, const std::vector<
         if (dist < minDist) minDist = dist;
     }
 
-    double delta = 3.0;
+    double delta = ConvexPolygonQuery::kDefaultDelta;
     if (minDist < delta) return 2;
 
     bool inside = false;
@@ -41,6 +59,329 @@ int PointInPolygonAlgorithms::check(const AlgoPoint2D& point, const std::vector<
     return inside ? 1 : 0;
 }
 
+int PointInPolygonAlgorithms::check(const AlgoPoint2D& point, const ConvexPolygonQuery& polygon) {
+    return polygon.check(point);
+}
+
+int PointInPolygonAlgorithms::check(const AlgoPoint2D& point, const EdgeIndex& index) {
+    if (index.polygon().size() < 3) return 0;
+    if (index.anyWithin(point, ConvexPolygonQuery::kDefaultDelta)) return 2;
+    return index.oddCrossings(point) ? 1 : 0;
+}
+
+PointInPolygonAlgorithms::EdgeArrays PointInPolygonAlgorithms::prepareEdges(const std::vector<AlgoPoint2D>& polygon) {
+    EdgeArrays edges;
+    edges.minX = edges.maxX = polygon[0].x;
+    edges.minY = edges.maxY = polygon[0].y;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const AlgoPoint2D& a = polygon[j];
+        const AlgoPoint2D& b = polygon[i];
+        edges.minX = std::min(edges.minX, b.x);
+        edges.minY = std::min(edges.minY, b.y);
+        edges.maxX = std::max(edges.maxX, b.x);
+        edges.maxY = std::max(edges.maxY, b.y);
+
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double l2 = dx * dx + dy * dy;
+        edges.ax.push_back(a.x);
+        edges.ay.push_back(a.y);
+        edges.dx.push_back(dx);
+        edges.dy.push_back(dy);
+        edges.invLength2.push_back(l2 > 0 ? 1.0 / l2 : 0.0);
+
+        // Горизонтальные рёбра луч не пересекают
+        if (dy == 0) continue;
+        double slope = dx / dy;
+        edges.yLow.push_back(std::min(a.y, b.y));
+        edges.yHigh.push_back(std::max(a.y, b.y));
+        edges.slope.push_back(slope);
+        edges.intercept.push_back(a.x - slope * a.y);
+    }
+    return edges;
+}
+
+void PointInPolygonAlgorithms::checkRange(const EdgeArrays& edges, const AlgoPoint2D* points, size_t begin,
+                                          size_t end, double delta, int* results) {
+    size_t crossingCount = edges.slope.size();
+    size_t edgeCount = edges.ax.size();
+    double delta2 = delta * delta;
+    size_t i = begin;
+
+#if defined(__AVX2__)
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d limit = _mm256_set1_pd(delta2);
+    const __m256d boxMinX = _mm256_set1_pd(edges.minX - delta), boxMaxX = _mm256_set1_pd(edges.maxX + delta);
+    const __m256d boxMinY = _mm256_set1_pd(edges.minY - delta), boxMaxY = _mm256_set1_pd(edges.maxY + delta);
+    for (; i + 4 <= end; i += 4) {
+        // x0 y0 x1 y1 | x2 y2 x3 y3 -> x0 x1 x2 x3 и y0 y1 y2 y3
+        __m256d lo = _mm256_loadu_pd(&points[i].x);
+        __m256d hi = _mm256_loadu_pd(&points[i + 2].x);
+        __m256d px = _mm256_permute4x64_pd(_mm256_unpacklo_pd(lo, hi), 0xD8);
+        __m256d py = _mm256_permute4x64_pd(_mm256_unpackhi_pd(lo, hi), 0xD8);
+
+        __m256d far = _mm256_or_pd(_mm256_or_pd(_mm256_cmp_pd(px, boxMinX, _CMP_LT_OQ),
+                                                _mm256_cmp_pd(px, boxMaxX, _CMP_GT_OQ)),
+                                   _mm256_or_pd(_mm256_cmp_pd(py, boxMinY, _CMP_LT_OQ),
+                                                _mm256_cmp_pd(py, boxMaxY, _CMP_GT_OQ)));
+        if (_mm256_movemask_pd(far) == 0xF) {
+            results[i] = results[i + 1] = results[i + 2] = results[i + 3] = 0;
+            continue;
+        }
+
+        __m256d inside = zero;
+        for (size_t e = 0; e < crossingCount; e++) {
+            __m256d x = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(edges.slope[e]), py),
+                                      _mm256_set1_pd(edges.intercept[e]));
+            __m256d hit = _mm256_and_pd(_mm256_cmp_pd(_mm256_set1_pd(edges.yLow[e]), py, _CMP_LE_OQ),
+                                        _mm256_cmp_pd(py, _mm256_set1_pd(edges.yHigh[e]), _CMP_LT_OQ));
+            hit = _mm256_and_pd(hit, _mm256_cmp_pd(px, x, _CMP_LT_OQ));
+            inside = _mm256_xor_pd(inside, hit);
+        }
+
+        __m256d minDist2 = _mm256_set1_pd(std::numeric_limits<double>::max());
+        for (size_t e = 0; e < edgeCount; e++) {
+            __m256d dx = _mm256_set1_pd(edges.dx[e]);
+            __m256d dy = _mm256_set1_pd(edges.dy[e]);
+            __m256d rx = _mm256_sub_pd(px, _mm256_set1_pd(edges.ax[e]));
+            __m256d ry = _mm256_sub_pd(py, _mm256_set1_pd(edges.ay[e]));
+            __m256d t = _mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(rx, dx), _mm256_mul_pd(ry, dy)),
+                                      _mm256_set1_pd(edges.invLength2[e]));
+            t = _mm256_min_pd(_mm256_max_pd(t, zero), one);
+            __m256d ex = _mm256_sub_pd(rx, _mm256_mul_pd(t, dx));
+            __m256d ey = _mm256_sub_pd(ry, _mm256_mul_pd(t, dy));
+            minDist2 = _mm256_min_pd(minDist2, _mm256_add_pd(_mm256_mul_pd(ex, ex), _mm256_mul_pd(ey, ey)));
+        }
+
+        int nearMask = _mm256_movemask_pd(_mm256_cmp_pd(minDist2, limit, _CMP_LT_OQ));
+        int insideMask = _mm256_movemask_pd(inside);
+        for (int lane = 0; lane < 4; lane++) {
+            results[i + lane] = (nearMask >> lane) & 1 ? 2 : (insideMask >> lane) & 1;
+        }
+    }
+#endif
+
+    for (; i < end; i++) {
+        const AlgoPoint2D& p = points[i];
+        if (p.x < edges.minX - delta || p.x > edges.maxX + delta ||
+            p.y < edges.minY - delta || p.y > edges.maxY + delta) {
+            results[i] = 0;
+            continue;
+        }
+
+        bool near = false;
+        for (size_t e = 0; e < edgeCount && !near; e++) {
+            double rx = p.x - edges.ax[e], ry = p.y - edges.ay[e];
+            double t = std::max(0.0, std::min(1.0, (rx * edges.dx[e] + ry * edges.dy[e]) * edges.invLength2[e]));
+            double ex = rx - t * edges.dx[e], ey = ry - t * edges.dy[e];
+            near = ex * ex + ey * ey < delta2;
+        }
+        if (near) {
+            results[i] = 2;
+            continue;
+        }
+
+        bool inside = false;
+        for (size_t e = 0; e < crossingCount; e++) {
+            if (edges.yLow[e] <= p.y && p.y < edges.yHigh[e] && p.x < edges.slope[e] * p.y + edges.intercept[e]) {
+                inside = !inside;
+            }
+        }
+        results[i] = inside ? 1 : 0;
+    }
+}
+
+void PointInPolygonAlgorithms::check(const AlgoPoint2D* points, size_t count, const std::vector<AlgoPoint2D>& polygon,
+                                     int* results, int threads) {
+    if (polygon.size() < 3) {
+        std::fill(results, results + count, 0);
+        return;
+    }
+
+    EdgeArrays edges = prepareEdges(polygon);
+    double delta = ConvexPolygonQuery::kDefaultDelta;
+
+    // Точки раздаются блоками через общий счётчик
+    const size_t blockSize = 4096;
+    std::atomic<size_t> nextBlock(0);
+    auto worker = [&]() {
+        for (size_t begin = nextBlock.fetch_add(blockSize); begin < count; begin = nextBlock.fetch_add(blockSize)) {
+            checkRange(edges, points, begin, std::min(count, begin + blockSize), delta, results);
+        }
+    };
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocks = (count + blockSize - 1) / blockSize;
+    threads = static_cast<int>(std::min<size_t>(threads, blocks));
+    if (threads <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (auto& thread : pool) thread.join();
+    }
+}
+
+ConvexPolygonQuery::ConvexPolygonQuery(const std::vector<AlgoPoint2D>& polygon, double delta)
+    : boundaryDelta(delta) {
+    if (polygon.size() < 3) return;
+
+    double area = 0;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        area += polygon[j].x * polygon[i].y - polygon[i].x * polygon[j].y;
+    }
+
+    // Обход против часовой стрелки без повторов и вершин на одной прямой
+    for (size_t k = 0; k < polygon.size(); k++) {
+        const AlgoPoint2D& p = polygon[area < 0 ? polygon.size() - 1 - k : k];
+        while (hull.size() >= 2 && orient(hull[hull.size() - 2], hull.back(), p) <= 0) hull.pop_back();
+        hull.push_back(p);
+    }
+    size_t first = 0;
+    while (hull.size() - first >= 3) {
+        if (orient(hull[hull.size() - 2], hull.back(), hull[first]) <= 0) hull.pop_back();
+        else if (orient(hull.back(), hull[first], hull[first + 1]) <= 0) first++;
+        else break;
+    }
+    hull.erase(hull.begin(), hull.begin() + first);
+    if (hull.size() < 3) {
+        hull.clear();
+        return;
+    }
+
+    inner = shrink(hull, delta);
+}
+
+// Пересечение полуплоскостей рёбер, сдвинутых внутрь на delta. Рёбра выпуклого
+// многоугольника уже упорядочены по углу, поэтому хватает одного прохода с деком.
+std::vector<AlgoPoint2D> ConvexPolygonQuery::shrink(const std::vector<AlgoPoint2D>& polygon, double delta) {
+    struct Line {
+        AlgoPoint2D a, d;
+    };
+    auto outside = [](const Line& line, const AlgoPoint2D& p) {
+        return line.d.x * (p.y - line.a.y) - line.d.y * (p.x - line.a.x) < 0;
+    };
+    auto intersect = [](const Line& l1, const Line& l2) {
+        double t = (l2.d.x * (l2.a.y - l1.a.y) - l2.d.y * (l2.a.x - l1.a.x)) /
+                   (l2.d.x * l1.d.y - l2.d.y * l1.d.x);
+        return AlgoPoint2D(l1.a.x + t * l1.d.x, l1.a.y + t * l1.d.y);
+    };
+    auto turnsLeft = [](const Line& l1, const Line& l2) {
+        return l1.d.x * l2.d.y - l1.d.y * l2.d.x > 0;
+    };
+
+    size_t n = polygon.size();
+    std::vector<Line> deque(n);
+    size_t head = 0, tail = 0;
+    for (size_t i = 0; i < n; i++) {
+        const AlgoPoint2D& a = polygon[i];
+        const AlgoPoint2D& b = polygon[(i + 1) % n];
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double len = std::sqrt(dx * dx + dy * dy);
+        Line line{AlgoPoint2D(a.x - dy / len * delta, a.y + dx / len * delta), AlgoPoint2D(dx, dy)};
+
+        while (tail - head >= 2 && outside(line, intersect(deque[tail - 2], deque[tail - 1]))) tail--;
+        while (tail - head >= 2 && outside(line, intersect(deque[head], deque[head + 1]))) head++;
+        // Соседние прямые ограниченной непустой области поворачивают меньше чем на пол-оборота
+        if (tail > head && !turnsLeft(deque[tail - 1], line)) return {};
+        deque[tail++] = line;
+    }
+    while (tail - head >= 3 && outside(deque[head], intersect(deque[tail - 2], deque[tail - 1]))) tail--;
+    while (tail - head >= 3 && outside(deque[tail - 1], intersect(deque[head], deque[head + 1]))) head++;
+    if (tail - head < 3 || !turnsLeft(deque[tail - 1], deque[head])) return {};
+
+    std::vector<AlgoPoint2D> result;
+    for (size_t i = head; i < tail; i++) {
+        result.push_back(intersect(deque[i], deque[i + 1 < tail ? i + 1 : head]));
+    }
+    return result;
+}
+
+// Клин веера из polygon[0], в который попадает луч к точке; false, если
+// точка вне угла при первой вершине
+bool ConvexPolygonQuery::locateWedge(const std::vector<AlgoPoint2D>& polygon, const AlgoPoint2D& p, size_t& wedge) {
+    size_t n = polygon.size();
+    const AlgoPoint2D& apex = polygon[0];
+    if (orient(apex, polygon[1], p) < 0 || orient(apex, polygon[n - 1], p) > 0) return false;
+
+    size_t lo = 1, hi = n - 1;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (orient(apex, polygon[mid], p) >= 0) lo = mid;
+        else hi = mid;
+    }
+    wedge = lo;
+    return true;
+}
+
+bool ConvexPolygonQuery::containsConvex(const std::vector<AlgoPoint2D>& polygon, const AlgoPoint2D& p) {
+    size_t wedge;
+    if (polygon.size() < 3 || !locateWedge(polygon, p, wedge)) return false;
+    return orient(polygon[wedge], polygon[wedge + 1], p) >= 0;
+}
+
+// Видимые из точки рёбра образуют цепочку, нормали которой занимают меньше
+// пол-оборота; её концы и ближайшее ребро на ней ищутся двоичным поиском
+double ConvexPolygonQuery::outsideDistance2(const AlgoPoint2D& p, size_t visibleEdge) const {
+    size_t n = hull.size();
+    auto direction = [&](size_t i) {
+        const AlgoPoint2D& b = hull[(i + 1) % n];
+        return AlgoPoint2D(b.x - hull[i].x, b.y - hull[i].y);
+    };
+    auto visible = [&](size_t i) { return orient(hull[i], hull[(i + 1) % n], p) < 0; };
+
+    AlgoPoint2D base = direction(visibleEdge);
+    auto chained = [&](size_t i, bool forward) {
+        AlgoPoint2D d = direction(i);
+        double turn = base.x * d.y - base.y * d.x;
+        return (forward ? turn > 0 : turn < 0) && visible(i);
+    };
+
+    size_t lo = 0, hi = n;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (chained((visibleEdge + mid) % n, true)) lo = mid;
+        else hi = mid;
+    }
+    size_t ahead = lo;
+
+    lo = 0, hi = n;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (chained((visibleEdge + n - mid) % n, false)) lo = mid;
+        else hi = mid;
+    }
+    size_t start = (visibleEdge + n - lo) % n;
+    size_t length = lo + ahead + 1;
+
+    // Первое ребро цепочки, за концом которого расстояние уже не убывает
+    lo = 0, hi = length - 1;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        size_t i = (start + mid) % n;
+        const AlgoPoint2D& b = hull[(i + 1) % n];
+        AlgoPoint2D d = direction(i);
+        if ((p.x - b.x) * d.x + (p.y - b.y) * d.y > 0) lo = mid + 1;
+        else hi = mid;
+    }
+    size_t edge = (start + lo) % n;
+    return segmentDistance2(p, hull[edge], hull[(edge + 1) % n]);
+}
+
+int ConvexPolygonQuery::check(const AlgoPoint2D& point) const {
+    if (empty()) return 0;
+
+    size_t wedge = 0;
+    bool inFan = locateWedge(hull, point, wedge);
+    if (inFan && orient(hull[wedge], hull[wedge + 1], point) >= 0) {
+        return containsConvex(inner, point) ? 1 : 2;
+    }
+
+    size_t visibleEdge = wedge;
+    if (!inFan) visibleEdge = orient(hull[0], hull[1], point) < 0 ? 0 : hull.size() - 1;
+    return outsideDistance2(point, visibleEdge) < boundaryDelta * boundaryDelta ? 2 : 0;
+}
+
 std::vector<AlgoPoint2D> ConvexHullAlgorithms::compute(const std::vector<AlgoPoint2D>& points) {
     if (points.size() < 3) return points;
 
@@ -75,3 +416,38 @@ std::vector<AlgoPoint2D> ConvexHullAlgorithms::compute(const std::vector<AlgoPoi
 
     return hull;
 }
+
+bool ConvexHullAlgorithms::insertPoint(std::vector<AlgoPoint2D>& hull, const AlgoPoint2D& point) {
+    size_t n = hull.size();
+    if (n < 3) {
+        std::vector<AlgoPoint2D> points = hull;
+        points.push_back(point);
+        hull = compute(points);
+        return true;
+    }
+
+    // Видимые рёбра идут подряд; ищется первое видимое после невидимого
+    auto visible = [&](size_t i) { return orient(hull[i], hull[(i + 1) % n], point) < 0; };
+    size_t first = n;
+    for (size_t i = 0; i < n; i++) {
+        if (visible(i) && !visible((i + n - 1) % n)) {
+            first = i;
+            break;
+        }
+    }
+    if (first == n) return false;
+
+    size_t last = first;
+    while (visible((last + 1) % n)) last = (last + 1) % n;
+
+    // Между hull[first] и hull[last + 1] остаётся только новая точка
+    std::vector<AlgoPoint2D> result;
+    result.reserve(n + 1);
+    for (size_t i = (last + 1) % n; ; i = (i + 1) % n) {
+        result.push_back(hull[i]);
+        if (i == first) break;
+    }
+    result.push_back(point);
+    hull.swap(result);
+    return true;
+}
@@ -11,19 +11,74 @@ struct AlgoPoint2D {
     AlgoPoint2D(double x = 0, double y = 0) : x(x), y(y) {}
 };
 
+class EdgeIndex;
+
+// Подготовленный выпуклый многоугольник для многократных проверок за O(log n).
+// Точка ищется двоичным поиском по клиньям веера из первой вершины. Внутренняя
+// точка лежит дальше delta от границы, только если попадает в многоугольник,
+// сжатый на delta (он строится один раз). Для внешней точки ближайшее ребро
+// ищется двоичным поиском по цепочке видимых рёбер, расстояния — в квадратах.
+class ConvexPolygonQuery {
+public:
+    static constexpr double kDefaultDelta = 3.0;
+
+    explicit ConvexPolygonQuery(const std::vector<AlgoPoint2D>& polygon = {}, double delta = kDefaultDelta);
+
+    // 0 — снаружи, 1 — внутри, 2 — ближе delta к границе, как в PointInPolygonAlgorithms::check
+    int check(const AlgoPoint2D& point) const;
+
+    // Точная проверка принадлежности замкнутому многоугольнику, без допуска
+    bool contains(const AlgoPoint2D& point) const { return containsConvex(hull, point); }
+
+    const std::vector<AlgoPoint2D>& polygon() const { return hull; }
+    double delta() const { return boundaryDelta; }
+    bool empty() const { return hull.size() < 3; }
+
+private:
+    static bool locateWedge(const std::vector<AlgoPoint2D>& polygon, const AlgoPoint2D& p, size_t& wedge);
+    static bool containsConvex(const std::vector<AlgoPoint2D>& polygon, const AlgoPoint2D& p);
+    static std::vector<AlgoPoint2D> shrink(const std::vector<AlgoPoint2D>& polygon, double delta);
+    double outsideDistance2(const AlgoPoint2D& p, size_t visibleEdge) const;
+
+    std::vector<AlgoPoint2D> hull;
+    std::vector<AlgoPoint2D> inner;
+    double boundaryDelta;
+};
+
 class PointInPolygonAlgorithms {
 private:
+    // Рёбра в виде отдельных массивов: для подсчёта пересечений лучом x = slope * y + intercept
+    // на [yLow, yHigh), для расстояния до границы — начало, направление и 1 / |d|^2
+    struct EdgeArrays {
+        std::vector<double> yLow, yHigh, slope, intercept;
+        std::vector<double> ax, ay, dx, dy, invLength2;
+        double minX, minY, maxX, maxY;
+    };
+
     static double cross(const AlgoPoint2D& a, const AlgoPoint2D& b, const AlgoPoint2D& c);
     static double distance(const AlgoPoint2D& a, const AlgoPoint2D& b);
     static double pointToSegmentDistance(const AlgoPoint2D& p, const AlgoPoint2D& a, const AlgoPoint2D& b);
+    static EdgeArrays prepareEdges(const std::vector<AlgoPoint2D>& polygon);
+    static void checkRange(const EdgeArrays& edges, const AlgoPoint2D* points, size_t begin, size_t end,
+                           double delta, int* results);
 
 public:
     static int check(const AlgoPoint2D& point, const std::vector<AlgoPoint2D>& polygon);
+    static int check(const AlgoPoint2D& point, const ConvexPolygonQuery& polygon);
+    // То же, что check(point, index.polygon()), но граница и пересечения ищутся по индексу рёбер
+    static int check(const AlgoPoint2D& point, const EdgeIndex& index);
+    // Пакетная проверка: results[i] совпадает с check(points[i], polygon). Четвёрки точек
+    // обрабатываются AVX2, если библиотека собрана с ним; threads = 0 — по числу ядер.
+    static void check(const AlgoPoint2D* points, size_t count, const std::vector<AlgoPoint2D>& polygon,
+                      int* results, int threads = 0);
 };
 
 class ConvexHullAlgorithms {
 public:
     static std::vector<AlgoPoint2D> compute(const std::vector<AlgoPoint2D>& points);
+    // Добавление точки к оболочке из compute за O(h): видимая из точки цепочка
+    // рёбер заменяется двумя рёбрами через неё. Возвращает false, если оболочка не изменилась.
+    static bool insertPoint(std::vector<AlgoPoint2D>& hull, const AlgoPoint2D& point);
 };
 
 #endif
@@ -9,6 +9,7 @@ void PolygonWidget::clearAll() {
     points.clear();
     convexHull.clear();
     convexHullPoints.clear();
+    hullQuery = ConvexPolygonQuery();
     testPoint = QPointF();
     testPointDragging = false;
     hullBuilt = false;
@@ -25,19 +26,32 @@ void PolygonWidget::buildConvexHull() {
     }
 
     convexHullPoints = ConvexHullAlgorithms::compute(algorithmPoints);
+    hullBuilt = true;
+    updateHull();
+}
+
+void PolygonWidget::updateHull() {
+    hullQuery = ConvexPolygonQuery(convexHullPoints);
     convexHull.clear();
     for (const auto& p : convexHullPoints) {
         convexHull << QPointF(p.x, p.y);
     }
-    hullBuilt = true;
+    if (!testPoint.isNull()) checkPoint();
     update();
 }
 
+// Точка внутри оболочки её не меняет; иначе оболочка достраивается без полного пересчёта
+void PolygonWidget::addHullPoint(const QPointF& pos) {
+    AlgoPoint2D p(pos.x(), pos.y());
+    if (hullQuery.contains(p)) return;
+    if (ConvexHullAlgorithms::insertPoint(convexHullPoints, p)) updateHull();
+}
+
 void PolygonWidget::checkPoint() {
-    if (!hullBuilt || convexHullPoints.empty()) return;
+    if (!hullBuilt || hullQuery.empty()) return;
 
     AlgoPoint2D test(testPoint.x(), testPoint.y());
-    result = PointInPolygonAlgorithms::check(test, convexHullPoints);
+    result = PointInPolygonAlgorithms::check(test, hullQuery);
     update();
 }
 
@@ -104,6 +118,7 @@ void PolygonWidget::mousePressEvent(QMouseEvent *event) {
             buildConvexHull();
         } else {
             points.push_back(pos);
+            if (hullBuilt) addHullPoint(pos);
             update();
         }
     }
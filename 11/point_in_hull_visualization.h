@@ -29,8 +29,14 @@ protected:
     void mouseDoubleClickEvent(QMouseEvent *event) override;
 
 private:
+    void addHullPoint(const QPointF& pos);
+    void updateHull();
+
     std::vector<QPointF> points;
     std::vector<AlgoPoint2D> convexHullPoints;
+    // Подготовленная оболочка: пересобирается только при изменении точек,
+    // проверка при перетаскивании тест-точки стоит O(log h)
+    ConvexPolygonQuery hullQuery;
     QPolygonF convexHull;
     QPointF testPoint;
     bool onlineMode;
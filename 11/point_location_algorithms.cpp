@@ -0,0 +1,337 @@
+#include "point_location_algorithms.h"
+
+SlabPointLocator::SlabPointLocator(const std::vector<std::vector<AlgoPoint2D>>& polygons, double tolerance)
+    : sloped(0), tolerance(tolerance) {
+    build(polygons);
+}
+
+SlabPointLocator::SlabPointLocator(const std::vector<AlgoPoint2D>& polygon, double tolerance)
+    : sloped(0), tolerance(tolerance) {
+    build(std::vector<std::vector<AlgoPoint2D>>{polygon});
+}
+
+void SlabPointLocator::build(const std::vector<std::vector<AlgoPoint2D>>& polygons) {
+    std::vector<Edge> edges;
+    for (const auto& polygon : polygons) {
+        if (polygon.size() < 3) continue;
+
+        for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+            AlgoPoint2D a = polygon[j];
+            AlgoPoint2D b = polygon[i];
+            breaks.push_back(b.x);
+            if (a.x == b.x) {
+                if (a.y != b.y) verticals.push_back({a.x, std::min(a.y, b.y), std::max(a.y, b.y)});
+                continue;
+            }
+            if (a.x > b.x) std::swap(a, b);
+            double slope = (b.y - a.y) / (b.x - a.x);
+            edges.push_back({a.x, b.x, slope, a.y - slope * a.x});
+        }
+    }
+
+    sloped = edges.size();
+    std::sort(breaks.begin(), breaks.end());
+    breaks.erase(std::unique(breaks.begin(), breaks.end()), breaks.end());
+    std::sort(verticals.begin(), verticals.end(),
+              [](const VerticalEdge& a, const VerticalEdge& b) { return a.x < b.x; });
+    if (breaks.size() < 2) return;
+
+    size_t slabs = breaks.size() - 1;
+    std::vector<std::pair<size_t, unsigned>> entries;
+    for (unsigned e = 0; e < edges.size(); e++) {
+        size_t from = std::lower_bound(breaks.begin(), breaks.end(), edges[e].x0) - breaks.begin();
+        size_t to = std::lower_bound(breaks.begin(), breaks.end(), edges[e].x1) - breaks.begin();
+        insert(1, 0, slabs, from, to, e, entries);
+    }
+
+    // Узел покрывает полосы целиком, и его рёбра сравниваются по y в середине узла
+    std::vector<double> middle(4 * slabs, 0.0);
+    std::vector<std::pair<size_t, size_t>> ranges(4 * slabs);
+    ranges[1] = std::make_pair(0, slabs);
+    for (size_t node = 1; node < 4 * slabs; node++) {
+        size_t l = ranges[node].first, r = ranges[node].second;
+        if (r <= l) continue;
+        middle[node] = (breaks[l] + breaks[r]) / 2;
+        if (r - l > 1 && 2 * node + 1 < 4 * slabs) {
+            size_t m = (l + r) / 2;
+            ranges[2 * node] = std::make_pair(l, m);
+            ranges[2 * node + 1] = std::make_pair(m, r);
+        }
+    }
+    std::sort(entries.begin(), entries.end(),
+              [&](const std::pair<size_t, unsigned>& a, const std::pair<size_t, unsigned>& b) {
+                  if (a.first != b.first) return a.first < b.first;
+                  double x = middle[a.first];
+                  return edges[a.second].y(x) < edges[b.second].y(x);
+              });
+
+    nodeOffsets.assign(4 * slabs + 1, 0);
+    for (const auto& entry : entries) nodeOffsets[entry.first + 1]++;
+    for (size_t node = 0; node < 4 * slabs; node++) nodeOffsets[node + 1] += nodeOffsets[node];
+    nodeEdges.reserve(entries.size());
+    for (const auto& entry : entries) nodeEdges.push_back(edges[entry.second]);
+}
+
+void SlabPointLocator::insert(size_t node, size_t l, size_t r, size_t from, size_t to, unsigned edge,
+                              std::vector<std::pair<size_t, unsigned>>& entries) {
+    if (to <= l || r <= from) return;
+    if (from <= l && r <= to) {
+        entries.push_back(std::make_pair(node, edge));
+        return;
+    }
+    size_t m = (l + r) / 2;
+    insert(2 * node, l, m, from, to, edge, entries);
+    insert(2 * node + 1, m, r, from, to, edge, entries);
+}
+
+// Число рёбер над точкой среди покрывающих полосу slab
+size_t SlabPointLocator::walk(size_t slab, const AlgoPoint2D& point, bool& onBoundary) const {
+    size_t above = 0;
+    size_t node = 1, l = 0, r = breaks.size() - 1;
+    while (true) {
+        const Edge* first = nodeEdges.data() + nodeOffsets[node];
+        const Edge* last = nodeEdges.data() + nodeOffsets[node + 1];
+        const Edge* split = std::partition_point(first, last, [&](const Edge& e) {
+            return e.y(point.x) <= point.y;
+        });
+        above += last - split;
+        if (split != last && split->y(point.x) - point.y <= tolerance) onBoundary = true;
+        if (split != first && point.y - (split - 1)->y(point.x) <= tolerance) onBoundary = true;
+
+        if (r - l <= 1) break;
+        size_t m = (l + r) / 2;
+        if (slab < m) {
+            node = 2 * node;
+            r = m;
+        } else {
+            node = 2 * node + 1;
+            l = m;
+        }
+    }
+    return above;
+}
+
+int SlabPointLocator::locate(const AlgoPoint2D& point) const {
+    auto vertical = std::lower_bound(verticals.begin(), verticals.end(), point.x - tolerance,
+                                     [](const VerticalEdge& v, double x) { return v.x < x; });
+    for (; vertical != verticals.end() && vertical->x <= point.x + tolerance; ++vertical) {
+        if (point.y >= vertical->y0 - tolerance && point.y <= vertical->y1 + tolerance) return 2;
+    }
+    if (breaks.size() < 2 || point.x < breaks.front() - tolerance || point.x > breaks.back() + tolerance) return 0;
+
+    // Полосы полуоткрыты [breaks[k], breaks[k + 1]); рёбра, кончающиеся в x точки,
+    // лежат в соседней слева полосе и проверяются только на касание
+    size_t slabs = breaks.size() - 1;
+    size_t next = std::upper_bound(breaks.begin(), breaks.end(), point.x) - breaks.begin();
+    bool onBoundary = false;
+    size_t above = 0;
+    if (next >= 1 && next <= slabs) above = walk(next - 1, point, onBoundary);
+    if (next >= 2 && point.x - breaks[next - 1] <= tolerance) walk(next - 2, point, onBoundary);
+    if (next <= slabs && breaks[next] - point.x <= tolerance) walk(next, point, onBoundary);
+    if (next == 0) walk(0, point, onBoundary);
+    if (next > slabs) walk(slabs - 1, point, onBoundary);
+
+    if (onBoundary) return 2;
+    return above % 2 == 1 ? 1 : 0;
+}
+
+GridPointLocator::GridPointLocator(const std::vector<AlgoPoint2D>& polygon, size_t resolution,
+                                   size_t memoryBudget, double delta)
+    : originX(0), originY(0), cellWidth(1), cellHeight(1), cols(0), rowCount(0), delta(delta) {
+    build(std::vector<std::vector<AlgoPoint2D>>{polygon}, resolution, memoryBudget);
+}
+
+GridPointLocator::GridPointLocator(const std::vector<std::vector<AlgoPoint2D>>& polygons, size_t resolution,
+                                   size_t memoryBudget, double delta)
+    : originX(0), originY(0), cellWidth(1), cellHeight(1), cols(0), rowCount(0), delta(delta) {
+    build(polygons, resolution, memoryBudget);
+}
+
+size_t GridPointLocator::memoryUsage() const {
+    return states.size() + (cellOffsets.size() + cellEdges.size()) * sizeof(unsigned) +
+           edges.size() * sizeof(GridEdge);
+}
+
+void GridPointLocator::build(const std::vector<std::vector<AlgoPoint2D>>& polygons, size_t resolution,
+                             size_t memoryBudget) {
+    for (const auto& polygon : polygons) {
+        if (polygon.size() < 3) continue;
+        for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+            edges.push_back({polygon[i], polygon[j]});
+        }
+    }
+    if (edges.empty()) return;
+
+    double minX = edges[0].a.x, maxX = minX, minY = edges[0].a.y, maxY = minY;
+    for (const auto& edge : edges) {
+        minX = std::min(minX, edge.a.x);
+        maxX = std::max(maxX, edge.a.x);
+        minY = std::min(minY, edge.a.y);
+        maxY = std::max(maxY, edge.a.y);
+    }
+    // Сетка покрывает габарит, расширенный на delta: дальше от неё точка всегда снаружи
+    originX = minX - delta;
+    originY = minY - delta;
+    double width = std::max(maxX - minX + 2 * delta, 1e-9);
+    double height = std::max(maxY - minY + 2 * delta, 1e-9);
+
+    if (resolution == 0) {
+        // Порядка четырёх клеток на ребро
+        double aspect = std::max(width, height) / std::min(width, height);
+        resolution = static_cast<size_t>(std::ceil(std::sqrt(4.0 * edges.size() * aspect)));
+    }
+    while (!layout(std::max<size_t>(resolution, 1), width, height, memoryBudget) && resolution > 1) {
+        resolution = resolution * 7 / 10;
+    }
+    if (states.empty()) layout(1, width, height, std::numeric_limits<size_t>::max());
+
+    classifyCells();
+}
+
+bool GridPointLocator::layout(size_t resolution, double width, double height, size_t memoryBudget) {
+    double shorter = std::min(width, height) / std::max(width, height);
+    size_t across = std::max<size_t>(1, static_cast<size_t>(std::ceil(resolution * shorter)));
+    cols = width >= height ? resolution : across;
+    rowCount = width >= height ? across : resolution;
+    cellWidth = width / cols;
+    cellHeight = height / rowCount;
+
+    size_t cells = cols * rowCount;
+    size_t fixed = cells * (1 + sizeof(unsigned));
+    if (fixed > memoryBudget) return false;
+
+    std::vector<unsigned> offsets(cells + 1, 0);
+    for (const auto& edge : edges) {
+        forEachCell(edge, [&](size_t cell) { offsets[cell + 1]++; });
+    }
+    for (size_t k = 0; k < cells; k++) offsets[k + 1] += offsets[k];
+    if (fixed + static_cast<size_t>(offsets[cells]) * sizeof(unsigned) > memoryBudget) return false;
+
+    cellEdges.assign(offsets[cells], 0);
+    std::vector<unsigned> fill(offsets.begin(), offsets.end() - 1);
+    for (unsigned e = 0; e < edges.size(); e++) {
+        forEachCell(edges[e], [&](size_t cell) { cellEdges[fill[cell]++] = e; });
+    }
+    cellOffsets.swap(offsets);
+
+    states.assign(cells, OUTSIDE_CELL);
+    for (size_t k = 0; k < cells; k++) {
+        if (cellOffsets[k + 1] > cellOffsets[k]) states[k] = BOUNDARY_CELL;
+    }
+    return true;
+}
+
+// Клетки, до которых отрезок подходит не дальше delta: в каждой строке берётся
+// часть отрезка в её полосе, расширенной на delta, и её x-диапазон плюс delta
+template <typename Visit>
+void GridPointLocator::forEachCell(const GridEdge& edge, Visit visit) const {
+    const double eps = 1e-9;
+    auto clampIndex = [](double value, size_t count) {
+        if (value < 0) return size_t(0);
+        return std::min(count - 1, static_cast<size_t>(value));
+    };
+
+    double dx = edge.b.x - edge.a.x, dy = edge.b.y - edge.a.y;
+    double low = std::min(edge.a.y, edge.b.y) - delta;
+    double high = std::max(edge.a.y, edge.b.y) + delta;
+    size_t firstRow = clampIndex(std::floor((low - originY) / cellHeight - eps), rowCount);
+    size_t lastRow = clampIndex(std::floor((high - originY) / cellHeight + eps), rowCount);
+
+    for (size_t r = firstRow; r <= lastRow; r++) {
+        double minX = std::min(edge.a.x, edge.b.x), maxX = std::max(edge.a.x, edge.b.x);
+        if (dy != 0) {
+            double t0 = (originY + r * cellHeight - delta - edge.a.y) / dy;
+            double t1 = (originY + (r + 1) * cellHeight + delta - edge.a.y) / dy;
+            if (t0 > t1) std::swap(t0, t1);
+            t0 = std::max(0.0, t0);
+            t1 = std::min(1.0, t1);
+            if (t0 > t1) continue;
+            minX = std::min(edge.a.x + t0 * dx, edge.a.x + t1 * dx);
+            maxX = std::max(edge.a.x + t0 * dx, edge.a.x + t1 * dx);
+        }
+        size_t firstColumn = clampIndex(std::floor((minX - delta - originX) / cellWidth - eps), cols);
+        size_t lastColumn = clampIndex(std::floor((maxX + delta - originX) / cellWidth + eps), cols);
+        for (size_t c = firstColumn; c <= lastColumn; c++) visit(r * cols + c);
+    }
+}
+
+// Состояние не граничных клеток — по чётности пересечений луча из их центра
+void GridPointLocator::classifyCells() {
+    std::vector<std::vector<double>> crossings(rowCount);
+    for (const auto& edge : edges) {
+        if (edge.a.y == edge.b.y) continue;
+        // Строки с центром в y-диапазоне ребра, с запасом в строку на округление
+        double low = (std::min(edge.a.y, edge.b.y) - originY) / cellHeight - 1.5;
+        double high = (std::max(edge.a.y, edge.b.y) - originY) / cellHeight + 0.5;
+        if (high < 0) continue;
+        size_t first = low < 0 ? 0 : static_cast<size_t>(low);
+        size_t last = std::min(rowCount - 1, static_cast<size_t>(high));
+        for (size_t r = first; r <= last; r++) {
+            double y = originY + (r + 0.5) * cellHeight;
+            if ((edge.a.y > y) != (edge.b.y > y)) {
+                crossings[r].push_back((edge.b.x - edge.a.x) * (y - edge.a.y) / (edge.b.y - edge.a.y) + edge.a.x);
+            }
+        }
+    }
+
+    for (size_t r = 0; r < rowCount; r++) {
+        std::vector<double>& xs = crossings[r];
+        std::sort(xs.begin(), xs.end());
+        size_t right = xs.size();
+        size_t count = 0;
+        for (size_t c = cols; c-- > 0;) {
+            double x = originX + (c + 0.5) * cellWidth;
+            while (right > 0 && xs[right - 1] > x) {
+                right--;
+                count++;
+            }
+            unsigned char& state = states[r * cols + c];
+            if (state != BOUNDARY_CELL) state = count % 2 == 1 ? INSIDE_CELL : OUTSIDE_CELL;
+        }
+    }
+}
+
+int GridPointLocator::check(const AlgoPoint2D& point) const {
+    if (states.empty()) return 0;
+
+    double fx = (point.x - originX) / cellWidth;
+    double fy = (point.y - originY) / cellHeight;
+    if (!(fx >= 0 && fy >= 0 && fx < cols && fy < rowCount)) return 0;
+
+    size_t c = static_cast<size_t>(fx);
+    size_t row = static_cast<size_t>(fy) * cols;
+    if (states[row + c] != BOUNDARY_CELL) return states[row + c];
+
+    double delta2 = delta * delta;
+    for (unsigned k = cellOffsets[row + c]; k < cellOffsets[row + c + 1]; k++) {
+        const GridEdge& edge = edges[cellEdges[k]];
+        double dx = edge.b.x - edge.a.x, dy = edge.b.y - edge.a.y;
+        double rx = point.x - edge.a.x, ry = point.y - edge.a.y;
+        double l2 = dx * dx + dy * dy;
+        double t = l2 > 0 ? std::max(0.0, std::min(1.0, (rx * dx + ry * dy) / l2)) : 0.0;
+        double ex = rx - t * dx, ey = ry - t * dy;
+        if (ex * ex + ey * ey < delta2) return 2;
+    }
+
+    // Пересечения луча вправо считаются по клеткам строки, каждое — в той клетке,
+    // на отрезок (low, high] которой оно приходится; первая не граничная клетка
+    // даёт чётность остатка луча
+    size_t parity = 0;
+    double low = point.x;
+    for (; c < cols; c++) {
+        size_t cell = row + c;
+        if (states[cell] != BOUNDARY_CELL) {
+            parity += states[cell];
+            break;
+        }
+        double high = originX + (c + 1) * cellWidth;
+        for (unsigned k = cellOffsets[cell]; k < cellOffsets[cell + 1]; k++) {
+            const GridEdge& edge = edges[cellEdges[k]];
+            if ((edge.a.y > point.y) == (edge.b.y > point.y)) continue;
+            double x = (edge.b.x - edge.a.x) * (point.y - edge.a.y) / (edge.b.y - edge.a.y) + edge.a.x;
+            if (x > low && x <= high) parity++;
+        }
+        low = high;
+    }
+    return parity % 2 == 1 ? 1 : 0;
+}
@@ -0,0 +1,97 @@
+#ifndef POINT_LOCATION_ALGORITHMS_H
+#define POINT_LOCATION_ALGORITHMS_H
+
+#include <vector>
+#include "point_in_hull_algorithms.h"
+
+// Локализация точки в произвольных простых многоугольниках и их наборах
+// (чётно-нечётное правило, как в PointInPolygonAlgorithms::check). Вертикальные
+// полосы между x-координатами вершин объединены в дерево отрезков: ребро хранится
+// в O(log n) узлах, целиком покрывающих его полосы, и внутри узла рёбра не
+// пересекаются, поэтому упорядочены по y. Построение O(n log^2 n), память
+// O(n log n), запрос — спуск к полосе точки с двоичным поиском в каждом узле, O(log^2 n).
+class SlabPointLocator {
+public:
+    explicit SlabPointLocator(const std::vector<std::vector<AlgoPoint2D>>& polygons = {}, double tolerance = 1e-9);
+    explicit SlabPointLocator(const std::vector<AlgoPoint2D>& polygon, double tolerance = 1e-9);
+
+    // 0 — снаружи, 1 — внутри, 2 — на ребре с точностью tolerance
+    int locate(const AlgoPoint2D& point) const;
+
+    size_t edgeCount() const { return sloped + verticals.size(); }
+
+private:
+    // Невертикальное ребро y = slope * x + intercept на [x0, x1)
+    struct Edge {
+        double x0, x1, slope, intercept;
+        double y(double x) const { return slope * x + intercept; }
+    };
+
+    struct VerticalEdge {
+        double x, y0, y1;
+    };
+
+    void build(const std::vector<std::vector<AlgoPoint2D>>& polygons);
+    static void insert(size_t node, size_t l, size_t r, size_t from, size_t to, unsigned edge,
+                       std::vector<std::pair<size_t, unsigned>>& entries);
+    size_t walk(size_t slab, const AlgoPoint2D& point, bool& onBoundary) const;
+
+    std::vector<double> breaks;
+    size_t sloped;
+    std::vector<VerticalEdge> verticals;
+    // Копии рёбер узлов дерева подряд, узел k занимает [nodeOffsets[k], nodeOffsets[k + 1])
+    std::vector<size_t> nodeOffsets;
+    std::vector<Edge> nodeEdges;
+    double tolerance;
+};
+
+// Равномерная сетка над многоугольником (или набором контуров). Клетка, до которой
+// ни одно ребро не подходит ближе delta, целиком внутри или снаружи, и ответ для
+// неё берётся из таблицы за O(1). Граничные клетки хранят список близких рёбер:
+// расстояние считается только до них, а чётность пересечений — по рёбрам клеток
+// строки правее точки до первой не граничной клетки. Ответы совпадают с
+// PointInPolygonAlgorithms::check при том же delta.
+class GridPointLocator {
+public:
+    static constexpr size_t kDefaultMemoryBudget = 64u << 20;
+
+    // resolution — число клеток по длинной стороне (0 — подобрать по числу рёбер);
+    // если клетки со списками рёбер не помещаются в memoryBudget байт, сетка огрубляется
+    explicit GridPointLocator(const std::vector<AlgoPoint2D>& polygon = {}, size_t resolution = 0,
+                              size_t memoryBudget = kDefaultMemoryBudget,
+                              double delta = ConvexPolygonQuery::kDefaultDelta);
+    explicit GridPointLocator(const std::vector<std::vector<AlgoPoint2D>>& polygons, size_t resolution = 0,
+                              size_t memoryBudget = kDefaultMemoryBudget,
+                              double delta = ConvexPolygonQuery::kDefaultDelta);
+
+    // 0 — снаружи, 1 — внутри, 2 — ближе delta к границе
+    int check(const AlgoPoint2D& point) const;
+
+    size_t columns() const { return cols; }
+    size_t rows() const { return rowCount; }
+    size_t memoryUsage() const;
+
+private:
+    enum CellState : unsigned char { OUTSIDE_CELL = 0, INSIDE_CELL = 1, BOUNDARY_CELL = 2 };
+
+    struct GridEdge {
+        AlgoPoint2D a, b;
+    };
+
+    void build(const std::vector<std::vector<AlgoPoint2D>>& polygons, size_t resolution, size_t memoryBudget);
+    bool layout(size_t resolution, double width, double height, size_t memoryBudget);
+    template <typename Visit>
+    void forEachCell(const GridEdge& edge, Visit visit) const;
+    void classifyCells();
+
+    std::vector<GridEdge> edges;
+    double originX, originY, cellWidth, cellHeight;
+    size_t cols, rowCount;
+    double delta;
+    std::vector<unsigned char> states;
+    // Рёбра граничных клеток подряд, клетка k занимает [cellOffsets[k], cellOffsets[k + 1])
+    std::vector<unsigned> cellOffsets;
+    std::vector<unsigned> cellEdges;
+};
+
+#endif
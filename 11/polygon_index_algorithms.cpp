@@ -0,0 +1,252 @@
+#include "polygon_index_algorithms.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+static const uint32_t kBufferMagic = 0x31545250;  // "PRT1"
+
+template <typename Task>
+void PolygonRTree::parallelFor(size_t count, int threads, Task task) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t k = next.fetch_add(1); k < count; k = next.fetch_add(1)) task(k);
+    };
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<int>(std::min<size_t>(threads, count));
+    if (threads <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (auto& thread : pool) thread.join();
+    }
+}
+
+PolygonRTree::PolygonRTree(const std::vector<std::vector<AlgoPoint2D>>& polygons, int threads)
+    : polygons(polygons), leafCount(0) {
+    prepareLocators(threads);
+    pack(threads);
+}
+
+void PolygonRTree::prepareLocators(int threads) {
+    boxes.assign(polygons.size(), Box{0, 0, -1, -1});
+    locators.assign(polygons.size(), GridPointLocator());
+    parallelFor(polygons.size(), threads, [&](size_t k) {
+        const auto& polygon = polygons[k];
+        if (polygon.size() < 3) return;
+
+        Box box{polygon[0].x, polygon[0].y, polygon[0].x, polygon[0].y};
+        for (const auto& p : polygon) {
+            box.minX = std::min(box.minX, p.x);
+            box.minY = std::min(box.minY, p.y);
+            box.maxX = std::max(box.maxX, p.x);
+            box.maxY = std::max(box.maxY, p.y);
+        }
+        boxes[k] = box;
+        locators[k] = GridPointLocator(polygon, 0, GridPointLocator::kDefaultMemoryBudget, 0.0);
+    });
+}
+
+void PolygonRTree::pack(int threads) {
+    nodes.clear();
+    entries.clear();
+    leafCount = 0;
+
+    // Упорядочивание STR: сортировка по x, полосы по s * kNodeCapacity элементов,
+    // сортировка полос по y; полосы сортируются параллельно
+    auto order = [&](const std::vector<Box>& items, std::vector<unsigned>& result) {
+        auto centerX = [&](unsigned k) { return items[k].minX + items[k].maxX; };
+        auto centerY = [&](unsigned k) { return items[k].minY + items[k].maxY; };
+        std::sort(result.begin(), result.end(), [&](unsigned a, unsigned b) { return centerX(a) < centerX(b); });
+
+        size_t groups = (result.size() + kNodeCapacity - 1) / kNodeCapacity;
+        size_t slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(groups))));
+        size_t sliceSize = slices * kNodeCapacity;
+        parallelFor(slices, threads, [&](size_t s) {
+            size_t begin = std::min(result.size(), s * sliceSize);
+            size_t end = std::min(result.size(), begin + sliceSize);
+            std::sort(result.begin() + begin, result.begin() + end,
+                      [&](unsigned a, unsigned b) { return centerY(a) < centerY(b); });
+        });
+    };
+    auto group = [&](const std::vector<Box>& items, const std::vector<unsigned>& sorted) {
+        std::vector<Node> level;
+        for (size_t begin = 0; begin < sorted.size(); begin += kNodeCapacity) {
+            size_t end = std::min(sorted.size(), begin + kNodeCapacity);
+            Node node{items[sorted[begin]], static_cast<unsigned>(begin), static_cast<unsigned>(end - begin)};
+            for (size_t k = begin + 1; k < end; k++) {
+                const Box& box = items[sorted[k]];
+                node.box.minX = std::min(node.box.minX, box.minX);
+                node.box.minY = std::min(node.box.minY, box.minY);
+                node.box.maxX = std::max(node.box.maxX, box.maxX);
+                node.box.maxY = std::max(node.box.maxY, box.maxY);
+            }
+            level.push_back(node);
+        }
+        return level;
+    };
+
+    for (unsigned k = 0; k < polygons.size(); k++) {
+        if (polygons[k].size() >= 3) entries.push_back(k);
+    }
+    if (entries.empty()) return;
+    order(boxes, entries);
+    std::vector<Node> level = group(boxes, entries);
+    leafCount = level.size();
+
+    // Каждый следующий уровень упорядочивает предыдущий, чтобы потомки узла шли подряд
+    std::vector<std::vector<Node>> levels;
+    while (true) {
+        if (level.size() == 1) {
+            levels.push_back(level);
+            break;
+        }
+        std::vector<Box> items;
+        for (const auto& node : level) items.push_back(node.box);
+        std::vector<unsigned> sorted(level.size());
+        for (unsigned k = 0; k < sorted.size(); k++) sorted[k] = k;
+        order(items, sorted);
+
+        std::vector<Node> reordered;
+        for (unsigned k : sorted) reordered.push_back(level[k]);
+        levels.push_back(reordered);
+        level = group(items, sorted);
+    }
+
+    size_t offset = 0;
+    for (size_t l = 0; l < levels.size(); l++) {
+        for (Node node : levels[l]) {
+            if (l > 0) node.first += static_cast<unsigned>(offset);
+            nodes.push_back(node);
+        }
+        if (l > 0) offset += levels[l - 1].size();
+    }
+}
+
+size_t PolygonRTree::locate(const AlgoPoint2D& point) const {
+    size_t best = kNoPolygon;
+    if (nodes.empty() || !nodes.back().box.contains(point)) return best;
+
+    // На каждом уровне в стек попадает не больше kNodeCapacity узлов
+    unsigned stack[kMaxLevels * kNodeCapacity];
+    size_t top = 0;
+    stack[top++] = static_cast<unsigned>(nodes.size() - 1);
+    while (top > 0) {
+        unsigned index = stack[--top];
+        const Node& node = nodes[index];
+        bool leaf = index < leafCount;
+
+        for (unsigned k = node.first; k < node.first + node.count; k++) {
+            if (!leaf) {
+                if (nodes[k].box.contains(point)) stack[top++] = k;
+                continue;
+            }
+            unsigned id = entries[k];
+            if (id < best && boxes[id].contains(point) && locators[id].check(point) != 0) best = id;
+        }
+    }
+    return best;
+}
+
+void PolygonRTree::locate(const AlgoPoint2D* points, size_t count, size_t* result, int threads) const {
+    const size_t blockSize = 1024;
+    parallelFor((count + blockSize - 1) / blockSize, threads, [&](size_t block) {
+        size_t end = std::min(count, (block + 1) * blockSize);
+        for (size_t k = block * blockSize; k < end; k++) result[k] = locate(points[k]);
+    });
+}
+
+std::vector<unsigned char> PolygonRTree::serialize() const {
+    std::vector<unsigned char> buffer;
+    auto append = [&](const void* data, size_t bytes) {
+        const unsigned char* begin = static_cast<const unsigned char*>(data);
+        buffer.insert(buffer.end(), begin, begin + bytes);
+    };
+
+    uint64_t vertexCount = 0;
+    std::vector<uint64_t> offsets(1, 0);
+    for (const auto& polygon : polygons) {
+        vertexCount += polygon.size();
+        offsets.push_back(vertexCount);
+    }
+    uint64_t header[5] = {polygons.size(), vertexCount, nodes.size(), leafCount, entries.size()};
+    append(&kBufferMagic, sizeof(kBufferMagic));
+    append(header, sizeof(header));
+    append(offsets.data(), offsets.size() * sizeof(uint64_t));
+    for (const auto& polygon : polygons) append(polygon.data(), polygon.size() * sizeof(AlgoPoint2D));
+    append(nodes.data(), nodes.size() * sizeof(Node));
+    append(entries.data(), entries.size() * sizeof(unsigned));
+    return buffer;
+}
+
+bool PolygonRTree::deserialize(const std::vector<unsigned char>& buffer, int threads) {
+    size_t position = 0;
+    auto read = [&](void* data, size_t bytes) {
+        if (bytes > buffer.size() - position) return false;
+        if (bytes > 0) std::memcpy(data, buffer.data() + position, bytes);
+        position += bytes;
+        return true;
+    };
+
+    uint32_t magic = 0;
+    uint64_t header[5];
+    if (!read(&magic, sizeof(magic)) || magic != kBufferMagic || !read(header, sizeof(header))) return false;
+    uint64_t polygonCount = header[0], vertexCount = header[1], nodeCount = header[2];
+    uint64_t leaves = header[3], entryCount = header[4];
+    // Размеры проверяются до выделения памяти
+    uint64_t rest = buffer.size() - position;
+    if (polygonCount >= rest / sizeof(uint64_t) || vertexCount > rest / sizeof(AlgoPoint2D) ||
+        nodeCount > rest / sizeof(Node) || entryCount > polygonCount || leaves > nodeCount) {
+        return false;
+    }
+
+    std::vector<uint64_t> offsets(polygonCount + 1);
+    if (!read(offsets.data(), offsets.size() * sizeof(uint64_t)) || offsets[0] != 0) return false;
+    std::vector<std::vector<AlgoPoint2D>> loaded(polygonCount);
+    for (size_t k = 0; k < polygonCount; k++) {
+        if (offsets[k + 1] < offsets[k] || offsets[k + 1] > vertexCount) return false;
+        loaded[k].resize(offsets[k + 1] - offsets[k]);
+        if (!read(loaded[k].data(), loaded[k].size() * sizeof(AlgoPoint2D))) return false;
+    }
+    std::vector<Node> loadedNodes(nodeCount);
+    std::vector<unsigned> loadedEntries(entryCount);
+    if (!read(loadedNodes.data(), loadedNodes.size() * sizeof(Node)) ||
+        !read(loadedEntries.data(), loadedEntries.size() * sizeof(unsigned)) || position != buffer.size()) {
+        return false;
+    }
+
+    // Дерево должно иметь форму, которую строит pack: каждый уровень в kNodeCapacity
+    // раз меньше предыдущего, корень — единственный узел последнего уровня, узел
+    // ссылается на 1..kNodeCapacity узлов уровня ниже (у листа — элементов entries).
+    // От этого зависит размер стека в locate.
+    if ((nodeCount == 0) != (leaves == 0) || (nodeCount == 0 && entryCount != 0)) return false;
+    uint64_t childBegin = 0, childEnd = entryCount;
+    uint64_t levelBegin = 0, levelSize = leaves;
+    for (size_t level = 0; levelSize > 0; level++) {
+        if (level >= kMaxLevels || levelBegin + levelSize > nodeCount) return false;
+        for (uint64_t k = levelBegin; k < levelBegin + levelSize; k++) {
+            const Node& node = loadedNodes[k];
+            uint64_t end = uint64_t(node.first) + node.count;
+            if (node.count == 0 || node.count > kNodeCapacity || node.first < childBegin || end > childEnd) {
+                return false;
+            }
+        }
+        childBegin = levelBegin;
+        childEnd = levelBegin + levelSize;
+        levelBegin = childEnd;
+        levelSize = levelSize == 1 ? 0 : (levelSize + kNodeCapacity - 1) / kNodeCapacity;
+    }
+    if (levelBegin != nodeCount) return false;
+    for (unsigned id : loadedEntries) {
+        if (id >= polygonCount) return false;
+    }
+
+    polygons.swap(loaded);
+    nodes.swap(loadedNodes);
+    entries.swap(loadedEntries);
+    leafCount = leaves;
+    prepareLocators(threads);
+    return true;
+}
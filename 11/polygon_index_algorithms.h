@@ -0,0 +1,61 @@
+#ifndef POLYGON_INDEX_ALGORITHMS_H
+#define POLYGON_INDEX_ALGORITHMS_H
+
+#include <vector>
+#include "point_location_algorithms.h"
+
+// Поиск многоугольника, содержащего точку, среди тысяч многоугольников.
+// Габариты упакованы в R-дерево методом STR (Sort-Tile-Recursive): на каждом
+// уровне прямоугольники сортируются по x, режутся на вертикальные полосы,
+// внутри полос сортируются по y и группируются по kNodeCapacity. Кандидаты,
+// чей габарит содержит точку, проверяются подготовленной сеткой своего
+// многоугольника (чётно-нечётное правило, без полосы допуска).
+class PolygonRTree {
+public:
+    static constexpr size_t kNoPolygon = static_cast<size_t>(-1);
+    static constexpr size_t kNodeCapacity = 16;
+
+    explicit PolygonRTree(const std::vector<std::vector<AlgoPoint2D>>& polygons = {}, int threads = 0);
+
+    // Наименьший номер многоугольника, содержащего точку, или kNoPolygon
+    size_t locate(const AlgoPoint2D& point) const;
+    void locate(const AlgoPoint2D* points, size_t count, size_t* result, int threads = 0) const;
+
+    // Плоский буфер: заголовок, вершины многоугольников, узлы дерева и порядок
+    // многоугольников в листьях. При загрузке дерево не перестраивается, заново
+    // готовятся только сетки многоугольников.
+    std::vector<unsigned char> serialize() const;
+    bool deserialize(const std::vector<unsigned char>& buffer, int threads = 0);
+
+    size_t size() const { return polygons.size(); }
+
+private:
+    // STR с kNodeCapacity = 16 даёт не больше 9 уровней на 2^32 многоугольников
+    static constexpr size_t kMaxLevels = 16;
+
+    struct Box {
+        double minX, minY, maxX, maxY;
+        bool contains(const AlgoPoint2D& p) const { return p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY; }
+    };
+
+    // Потомки узла — узлы [first, first + count) уровня ниже, у листа — элементы entries
+    struct Node {
+        Box box;
+        unsigned first, count;
+    };
+
+    void prepareLocators(int threads);
+    void pack(int threads);
+    template <typename Task>
+    static void parallelFor(size_t count, int threads, Task task);
+
+    std::vector<std::vector<AlgoPoint2D>> polygons;
+    std::vector<Box> boxes;
+    std::vector<GridPointLocator> locators;
+    // Уровни хранятся снизу вверх, корень — последний узел
+    std::vector<Node> nodes;
+    size_t leafCount;
+    std::vector<unsigned> entries;
+};
+
+#endif
@@ -1,4 +1,11 @@
 #include "bezier_algorithms.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 double BezierAlgorithms::binomialCoefficient(int n, int k) {
     if (k < 0 || k > n) return 0;
@@ -11,54 +18,344 @@ double BezierAlgorithms::binomialCoefficient(int n, int k) {
     return result;
 }
 
-AlgoPoint BezierAlgorithms::bezierPoint(const std::vector<AlgoPoint>& points, double t) {
-    int n = points.size() - 1;
-    AlgoPoint result(0, 0);
+// Веса строятся той же рекуррентностью, что и де Кастельжо:
+// B_i^k(t) = (1 - t) B_i^(k-1)(t) + t B_(i-1)^(k-1)(t). На концах получаются точные 0 и 1.
+BernsteinBasis::BernsteinBasis(int degree, int segments)
+    : degree(degree), segments(segments), blocks(segments / 4 + 1) {
+    size_t count = degree + 1;
+    weights.resize(blocks * count);
+    std::vector<double> b(count);
+    for (int j = 0; j <= segments; j++) {
+        double t = static_cast<double>(j) / segments;
+        double s = 1 - t;
+        b.assign(count, 0.0);
+        b[0] = 1;
+        for (size_t k = 1; k < count; k++) {
+            for (size_t i = k; i > 0; i--) b[i] = s * b[i] + t * b[i - 1];
+            b[0] *= s;
+        }
+        for (size_t i = 0; i < count; i++) weights[(j / 4) * count + i].t[j % 4] = b[i];
+    }
+}
+
+std::mutex& BernsteinBasisCache::mutex() {
+    static std::mutex instance;
+    return instance;
+}
+
+std::map<std::pair<int, int>, BernsteinBasis>& BernsteinBasisCache::tables() {
+    static std::map<std::pair<int, int>, BernsteinBasis> instance;
+    return instance;
+}
+
+size_t& BernsteinBasisCache::usedBytes() {
+    static size_t instance = 0;
+    return instance;
+}
 
-    for (int i = 0; i <= n; i++) {
-        double coeff = binomialCoefficient(n, i) * pow(1 - t, n - i) * pow(t, i);
-        result.x += coeff * points[i].x;
-        result.y += coeff * points[i].y;
+size_t BernsteinBasisCache::memoryUsage() {
+    std::lock_guard<std::mutex> lock(mutex());
+    return usedBytes();
+}
+
+const BernsteinBasis* BernsteinBasisCache::get(int degree, int segments) {
+    if (degree < 0 || degree > kMaxDegree || segments < 1 || segments > kMaxSegments) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex());
+    auto key = std::make_pair(degree, segments);
+    auto it = tables().find(key);
+    if (it != tables().end()) return &it->second;
+
+    size_t bytes = (segments / 4 + 1) * (degree + 1) * sizeof(BernsteinBasis::Lanes);
+    if (bytes > kMemoryBudget - usedBytes()) return nullptr;
+    usedBytes() += bytes;
+    return &tables().emplace(key, BernsteinBasis(degree, segments)).first->second;
+}
+
+AlgoPoint BezierAlgorithms::deCasteljau(const std::vector<AlgoPoint>& points, double t,
+                                        std::vector<AlgoPoint>& scratch) {
+    scratch.assign(points.begin(), points.end());
+    double s = 1 - t;
+    for (size_t level = scratch.size() - 1; level > 0; level--) {
+        for (size_t i = 0; i < level; i++) {
+            scratch[i].x = s * scratch[i].x + t * scratch[i + 1].x;
+            scratch[i].y = s * scratch[i].y + t * scratch[i + 1].y;
+        }
     }
+    return scratch[0];
+}
 
-    return result;
+AlgoPoint BezierAlgorithms::bezierPoint(const std::vector<AlgoPoint>& points, double t) {
+    if (points.empty()) return AlgoPoint();
+    std::vector<AlgoPoint> scratch;
+    return deCasteljau(points, t, scratch);
 }
 
-std::vector<AlgoPoint> BezierAlgorithms::computeBezierQuadratic(const std::vector<AlgoPoint>& points, int segments) {
-    if (points.size() < 3) return {};
+// Кривая переводится в степенной базис p(t) = sum a_k t^k, и начальные разности
+// с шагом h берутся точно: разность порядка j от t^k в нуле равна
+// h^k * j! * S(k, j), где S — числа Стирлинга второго рода. Разности,
+// снятые с уже вычисленных точек, теряли бы знаки при вычитании.
+void BezierAlgorithms::sampleForwardDifferences(const std::vector<AlgoPoint>& points, int segments,
+                                                std::vector<AlgoPoint>& curve) {
+    const int maxDegree = kForwardDifferenceMaxDegree;
+    int n = static_cast<int>(points.size()) - 1;
 
-    std::vector<AlgoPoint> curve;
+    AlgoPoint power[maxDegree + 1];
+    for (int k = 0; k <= n; k++) {
+        double x = 0, y = 0;
+        for (int i = 0; i <= k; i++) {
+            double c = binomialCoefficient(k, i) * ((k - i) % 2 == 0 ? 1 : -1);
+            x += c * points[i].x;
+            y += c * points[i].y;
+        }
+        double scale = binomialCoefficient(n, k);
+        power[k] = AlgoPoint(scale * x, scale * y);
+    }
+
+    double stirling[maxDegree + 1][maxDegree + 1] = {};
+    stirling[0][0] = 1;
+    for (int k = 1; k <= n; k++) {
+        for (int j = 1; j <= k; j++) {
+            stirling[k][j] = j * stirling[k - 1][j] + stirling[k - 1][j - 1];
+        }
+    }
+
+    double h = 1.0 / segments;
+    AlgoPoint diff[maxDegree + 1];
+    double factorial = 1;
+    for (int j = 0; j <= n; j++) {
+        if (j > 0) factorial *= j;
+        double x = 0, y = 0;
+        double hk = 1;
+        for (int k = 0; k <= n; k++) {
+            double c = hk * factorial * stirling[k][j];
+            x += c * power[k].x;
+            y += c * power[k].y;
+            hk *= h;
+        }
+        diff[j] = AlgoPoint(x, y);
+    }
+
+    curve.resize(segments + 1);
     for (int i = 0; i <= segments; i++) {
-        double t = static_cast<double>(i) / segments;
-        AlgoPoint p = bezierPoint(points, t);
-        curve.push_back(p);
+        curve[i] = diff[0];
+        for (int j = 0; j < n; j++) {
+            diff[j].x += diff[j + 1].x;
+            diff[j].y += diff[j + 1].y;
+        }
     }
+    curve.front() = points.front();
+    curve.back() = points.back();
+}
 
-    return curve;
+void BezierAlgorithms::sampleBasis(const BernsteinBasis& basis, const std::vector<AlgoPoint>& points,
+                                   std::vector<AlgoPoint>& curve) {
+    size_t count = basis.degree + 1;
+    size_t samples = basis.segments + 1;
+    curve.resize(samples);
+
+    alignas(32) double x[4];
+    alignas(32) double y[4];
+    for (size_t b = 0; b < basis.blocks; b++) {
+        const BernsteinBasis::Lanes* w = &basis.weights[b * count];
+#if defined(__AVX2__)
+        __m256d sumX = _mm256_setzero_pd();
+        __m256d sumY = _mm256_setzero_pd();
+        for (size_t i = 0; i < count; i++) {
+            __m256d weight = _mm256_load_pd(w[i].t);
+            sumX = _mm256_add_pd(sumX, _mm256_mul_pd(weight, _mm256_set1_pd(points[i].x)));
+            sumY = _mm256_add_pd(sumY, _mm256_mul_pd(weight, _mm256_set1_pd(points[i].y)));
+        }
+        _mm256_store_pd(x, sumX);
+        _mm256_store_pd(y, sumY);
+#else
+        for (int k = 0; k < 4; k++) x[k] = y[k] = 0;
+        for (size_t i = 0; i < count; i++) {
+            for (int k = 0; k < 4; k++) {
+                x[k] += w[i].t[k] * points[i].x;
+                y[k] += w[i].t[k] * points[i].y;
+            }
+        }
+#endif
+        size_t first = b * 4;
+        for (size_t k = 0; k < 4 && first + k < samples; k++) curve[first + k] = AlgoPoint(x[k], y[k]);
+    }
 }
 
-std::vector<AlgoPoint> BezierAlgorithms::computeBezierCubic(const std::vector<AlgoPoint>& points, int segments) {
-    if (points.size() < 4) return {};
+std::vector<AlgoPoint> BezierAlgorithms::sampleUniform(const std::vector<AlgoPoint>& points, int segments) {
+    if (points.empty() || segments < 1) return {};
 
     std::vector<AlgoPoint> curve;
+    int degree = static_cast<int>(points.size()) - 1;
+    const BernsteinBasis* basis = BernsteinBasisCache::get(degree, segments);
+    if (basis) {
+        sampleBasis(*basis, points, curve);
+        return curve;
+    }
+
+    if (degree <= kForwardDifferenceMaxDegree) {
+        sampleForwardDifferences(points, segments, curve);
+        return curve;
+    }
+
+    curve.reserve(segments + 1);
+    std::vector<AlgoPoint> scratch;
     for (int i = 0; i <= segments; i++) {
         double t = static_cast<double>(i) / segments;
-        AlgoPoint p = bezierPoint(points, t);
-        curve.push_back(p);
+        curve.push_back(deCasteljau(points, t, scratch));
+    }
+    return curve;
+}
+
+double BezierAlgorithms::flatness(const AlgoPoint* points, size_t count) {
+    size_t n = count - 1;
+    const AlgoPoint& a = points[0];
+    double dx = points[n].x - a.x;
+    double dy = points[n].y - a.y;
+    double len2 = dx * dx + dy * dy;
+
+    double second2 = 0, hull2 = 0;
+    for (size_t i = 0; i + 2 <= n; i++) {
+        double x = points[i + 2].x - 2 * points[i + 1].x + points[i].x;
+        double y = points[i + 2].y - 2 * points[i + 1].y + points[i].y;
+        second2 = std::max(second2, x * x + y * y);
+    }
+    for (size_t i = 1; i < n; i++) {
+        double along = (points[i].x - a.x) * dx + (points[i].y - a.y) * dy;
+        double t = len2 > 0 ? std::max(0.0, std::min(1.0, along / len2)) : 0.0;
+        double x = points[i].x - (a.x + t * dx);
+        double y = points[i].y - (a.y + t * dy);
+        hull2 = std::max(hull2, x * x + y * y);
+    }
+    return std::min(n * (n - 1) / 8.0 * std::sqrt(second2), std::sqrt(hull2));
+}
+
+void BezierAlgorithms::subdivide(const AlgoPoint* points, size_t count, AlgoPoint* left, AlgoPoint* right,
+                                 std::vector<AlgoPoint>& level) {
+    // Половины кривой — стороны треугольника де Кастельжо при t = 1/2
+    level.assign(points, points + count);
+    for (size_t k = 0; k < count; k++) {
+        left[k] = level[0];
+        right[count - 1 - k] = level[count - 1 - k];
+        for (size_t i = 0; i + 1 < count - k; i++) {
+            level[i].x = (level[i].x + level[i + 1].x) / 2;
+            level[i].y = (level[i].y + level[i + 1].y) / 2;
+        }
     }
+}
 
+std::vector<AlgoPoint> BezierAlgorithms::flattenAdaptive(const std::vector<AlgoPoint>& points, double tolerance) {
+    // Нулевой, отрицательный или NaN допуск довёл бы деление до предельной глубины
+    if (points.empty() || !(tolerance > 0)) return {};
+
+    std::vector<AlgoPoint> curve;
+    curve.push_back(points.front());
+    size_t count = points.size();
+    if (count == 1) return curve;
+
+    // Явный стек кусков: каждое деление заменяет верхний кусок двумя, поэтому
+    // глубже kMaxSubdivisionDepth + 1 кусков он не растёт. Левая половина
+    // кладётся сверху, и концы кусков выходят в порядке вдоль кривой.
+    std::vector<AlgoPoint> stack((kMaxSubdivisionDepth + 1) * count);
+    std::vector<int> depths(kMaxSubdivisionDepth + 1);
+    std::vector<AlgoPoint> level(count);
+    std::copy(points.begin(), points.end(), stack.begin());
+    depths[0] = 0;
+    size_t top = 0;
+    while (true) {
+        AlgoPoint* piece = &stack[top * count];
+        int depth = depths[top];
+        if (depth >= kMaxSubdivisionDepth || flatness(piece, count) <= tolerance) {
+            curve.push_back(piece[count - 1]);
+            if (top == 0) break;
+            top--;
+            continue;
+        }
+        subdivide(piece, count, piece + count, piece, level);
+        depths[top] = depths[top + 1] = depth + 1;
+        top++;
+    }
     return curve;
 }
 
+std::vector<AlgoPoint> BezierAlgorithms::computeBezierQuadratic(const std::vector<AlgoPoint>& points, int segments) {
+    if (points.size() < 3) return {};
+    return sampleUniform(points, segments);
+}
+
+std::vector<AlgoPoint> BezierAlgorithms::computeBezierCubic(const std::vector<AlgoPoint>& points, int segments) {
+    if (points.size() < 4) return {};
+    return sampleUniform(points, segments);
+}
+
 std::vector<AlgoPoint> BezierAlgorithms::computeBezierNthOrder(const std::vector<AlgoPoint>& points, int segments, int order) {
     if (points.size() < order + 1) return {};
+    return sampleUniform(points, segments);
+}
 
-    std::vector<AlgoPoint> curve;
-    for (int i = 0; i <= segments; i++) {
-        double t = static_cast<double>(i) / segments;
-        AlgoPoint p = bezierPoint(points, t);
-        curve.push_back(p);
+void BezierAlgorithms::evaluateCubicRange(const CubicBatch& curves, const BernsteinBasis& basis,
+                                          size_t begin, size_t end, double* outX, double* outY) {
+    size_t count = curves.count;
+    for (int j = 0; j <= basis.segments; j++) {
+        const BernsteinBasis::Lanes* w = &basis.weights[(j / 4) * 4];
+        double w0 = w[0].t[j % 4], w1 = w[1].t[j % 4], w2 = w[2].t[j % 4], w3 = w[3].t[j % 4];
+        double* rowX = outX + j * count;
+        double* rowY = outY + j * count;
+
+        size_t c = begin;
+#if defined(__AVX2__)
+        __m256d b0 = _mm256_set1_pd(w0), b1 = _mm256_set1_pd(w1);
+        __m256d b2 = _mm256_set1_pd(w2), b3 = _mm256_set1_pd(w3);
+        for (; c + 4 <= end; c += 4) {
+            __m256d x = _mm256_mul_pd(b0, _mm256_loadu_pd(curves.x[0] + c));
+            x = _mm256_add_pd(x, _mm256_mul_pd(b1, _mm256_loadu_pd(curves.x[1] + c)));
+            x = _mm256_add_pd(x, _mm256_mul_pd(b2, _mm256_loadu_pd(curves.x[2] + c)));
+            x = _mm256_add_pd(x, _mm256_mul_pd(b3, _mm256_loadu_pd(curves.x[3] + c)));
+            __m256d y = _mm256_mul_pd(b0, _mm256_loadu_pd(curves.y[0] + c));
+            y = _mm256_add_pd(y, _mm256_mul_pd(b1, _mm256_loadu_pd(curves.y[1] + c)));
+            y = _mm256_add_pd(y, _mm256_mul_pd(b2, _mm256_loadu_pd(curves.y[2] + c)));
+            y = _mm256_add_pd(y, _mm256_mul_pd(b3, _mm256_loadu_pd(curves.y[3] + c)));
+            _mm256_storeu_pd(rowX + c, x);
+            _mm256_storeu_pd(rowY + c, y);
+        }
+#endif
+        for (; c < end; c++) {
+            rowX[c] = w0 * curves.x[0][c] + w1 * curves.x[1][c] + w2 * curves.x[2][c] + w3 * curves.x[3][c];
+            rowY[c] = w0 * curves.y[0][c] + w1 * curves.y[1][c] + w2 * curves.y[2][c] + w3 * curves.y[3][c];
+        }
     }
+}
 
-    return curve;
+void BezierAlgorithms::evaluateCubics(const CubicBatch& curves, int segments, double* outX, double* outY,
+                                      int threads) {
+    if (curves.count == 0 || segments < 1) return;
+
+    BernsteinBasis local;
+    const BernsteinBasis* basis = BernsteinBasisCache::get(3, segments);
+    if (!basis) {
+        local = BernsteinBasis(3, segments);
+        basis = &local;
+    }
+
+    // Блок кривых вместе с опорными точками помещается в кеш второго уровня,
+    // и все отсчёты блока считаются по нему
+    const size_t blockSize = 1024;
+    std::atomic<size_t> nextBlock(0);
+    auto worker = [&]() {
+        for (size_t begin = nextBlock.fetch_add(blockSize); begin < curves.count;
+             begin = nextBlock.fetch_add(blockSize)) {
+            evaluateCubicRange(curves, *basis, begin, std::min(curves.count, begin + blockSize), outX, outY);
+        }
+    };
+
+    if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t blocks = (curves.count + blockSize - 1) / blockSize;
+    threads = static_cast<int>(std::min<size_t>(threads, blocks));
+    if (threads <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+        for (auto& thread : pool) thread.join();
+    }
 }
@@ -1,6 +1,9 @@
 #ifndef BEZIER_ALGORITHMS_H
 #define BEZIER_ALGORITHMS_H
 
+#include <map>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <cmath>
 
@@ -9,14 +12,95 @@ struct AlgoPoint {
     AlgoPoint(double x = 0, double y = 0) : x(x), y(y) {}
 };
 
+// Значения базиса Бернштейна B_i(t_j) при t_j = j / segments. Параметры
+// сгруппированы по четыре: в блоке b подряд лежат веса всех базисных функций
+// для t_4b..t_4b+3, каждая четвёрка выровнена на 32 байта.
+struct BernsteinBasis {
+    struct alignas(32) Lanes {
+        double t[4];
+    };
+
+    int degree;
+    int segments;
+    size_t blocks;
+    std::vector<Lanes> weights;   // weights[b * (degree + 1) + i].t[k] = B_i(t_4b+k)
+
+    BernsteinBasis(int degree = 0, int segments = 0);
+};
+
+// Таблицы базиса, общие для всех вызовов с той же парой (степень, число отрезков).
+// Таблицы не удаляются, и указатель остаётся действительным до конца программы.
+// Поэтому весь кеш ограничен kMemoryBudget байт: когда бюджет исчерпан, новые
+// пары не кешируются, и выборка идёт без таблицы.
+class BernsteinBasisCache {
+public:
+    static constexpr int kMaxDegree = 16;
+    static constexpr int kMaxSegments = 1024;
+    static constexpr size_t kMemoryBudget = 4 << 20;
+
+    // nullptr, если таблица такого размера не кешируется или не помещается в бюджет
+    static const BernsteinBasis* get(int degree, int segments);
+    static size_t memoryUsage();
+
+private:
+    static std::mutex& mutex();
+    static std::map<std::pair<int, int>, BernsteinBasis>& tables();
+    static size_t& usedBytes();
+};
+
+// Опорные точки многих кубических кривых в виде структуры массивов:
+// кривая c задана точками (x[k][c], y[k][c]), k = 0..3
+struct CubicBatch {
+    const double* x[4];
+    const double* y[4];
+    size_t count;
+
+    CubicBatch() : x(), y(), count(0) {}
+};
+
+// Степень кривой — число точек минус один. Равномерная выборка берёт таблицу
+// базиса из кеша и сводится к произведению матрицы на вектор, по четыре t за раз.
+// Если таблица не кешируется, степени до kForwardDifferenceMaxDegree считаются
+// прямыми разностями (n сложений на точку), а старшие — устойчивым
+// алгоритмом де Кастельжо.
 class BezierAlgorithms {
 public:
+    static constexpr int kForwardDifferenceMaxDegree = 3;
+
     static std::vector<AlgoPoint> computeBezierQuadratic(const std::vector<AlgoPoint>& points, int segments);
     static std::vector<AlgoPoint> computeBezierCubic(const std::vector<AlgoPoint>& points, int segments);
     static std::vector<AlgoPoint> computeBezierNthOrder(const std::vector<AlgoPoint>& points, int segments, int order);
 
-private:
+    // Точка кривой при параметре t по де Кастельжо
     static AlgoPoint bezierPoint(const std::vector<AlgoPoint>& points, double t);
+
+    // Адаптивная ломаная: кривая делится пополам, пока отклонение от хорды не
+    // станет меньше tolerance. Оценка отклонения сверху — меньшая из двух:
+    // через вторые разности, n(n - 1) / 8 * max |P[i+2] - 2P[i+1] + P[i]|,
+    // и по выпуклой оболочке, max расстояния от опорных точек до хорды.
+    // Число точек — размер результата; при tolerance <= 0 или NaN он пуст.
+    static std::vector<AlgoPoint> flattenAdaptive(const std::vector<AlgoPoint>& points, double tolerance);
+    static constexpr int kMaxSubdivisionDepth = 16;
+
+    // Выборка count кубических кривых в segments + 1 равномерных точках.
+    // Результат пишется в заранее выделенные массивы по (segments + 1) * count
+    // элементов по отсчётам: точка j кривой c лежит в outX[j * count + c].
+    // Кривые идут по дорожкам AVX2, по четыре за раз, а блоки кривых — по потокам.
+    static void evaluateCubics(const CubicBatch& curves, int segments, double* outX, double* outY,
+                               int threads = 0);
+
+private:
+    static std::vector<AlgoPoint> sampleUniform(const std::vector<AlgoPoint>& points, int segments);
+    static void evaluateCubicRange(const CubicBatch& curves, const BernsteinBasis& basis,
+                                   size_t begin, size_t end, double* outX, double* outY);
+    static void sampleBasis(const BernsteinBasis& basis, const std::vector<AlgoPoint>& points,
+                            std::vector<AlgoPoint>& curve);
+    static void sampleForwardDifferences(const std::vector<AlgoPoint>& points, int segments,
+                                         std::vector<AlgoPoint>& curve);
+    static double flatness(const AlgoPoint* points, size_t count);
+    static void subdivide(const AlgoPoint* points, size_t count, AlgoPoint* left, AlgoPoint* right,
+                          std::vector<AlgoPoint>& level);
+    static AlgoPoint deCasteljau(const std::vector<AlgoPoint>& points, double t, std::vector<AlgoPoint>& scratch);
     static double binomialCoefficient(int n, int k);
 };
 
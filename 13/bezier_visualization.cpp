@@ -1,7 +1,7 @@
 #include "bezier_visualization.h"
 
 BezierWidget::BezierWidget(QWidget *parent) : QWidget(parent),
-    showQuadratic(true), showCubic(true), showNthOrder(true), currentOrder(5) {
+    showQuadratic(true), showCubic(true), showNthOrder(true), adaptive(false), currentOrder(5) {
     setMouseTracking(true);
     setMinimumSize(1000, 700);
 }
@@ -33,7 +33,8 @@ void BezierWidget::updateCurves() {
         for (int i = 0; i < std::min(3, (int)points.size()); i++) {
             quadPoints.push_back(algoPoints[i]);
         }
-        auto quadResult = BezierAlgorithms::computeBezierQuadratic(quadPoints, 100);
+        auto quadResult = adaptive ? BezierAlgorithms::flattenAdaptive(quadPoints, kFlatnessTolerance)
+                                   : BezierAlgorithms::computeBezierQuadratic(quadPoints, 100);
         quadraticCurve.clear();
         for (const auto& p : quadResult) {
             quadraticCurve.emplace_back(p.x, p.y);
@@ -47,7 +48,8 @@ void BezierWidget::updateCurves() {
         for (int i = 0; i < std::min(4, (int)points.size()); i++) {
             cubicPoints.push_back(algoPoints[i]);
         }
-        auto cubicResult = BezierAlgorithms::computeBezierCubic(cubicPoints, 100);
+        auto cubicResult = adaptive ? BezierAlgorithms::flattenAdaptive(cubicPoints, kFlatnessTolerance)
+                                    : BezierAlgorithms::computeBezierCubic(cubicPoints, 100);
         cubicCurve.clear();
         for (const auto& p : cubicResult) {
             cubicCurve.emplace_back(p.x, p.y);
@@ -61,7 +63,8 @@ void BezierWidget::updateCurves() {
         for (int i = 0; i < std::min(currentOrder + 1, (int)points.size()); i++) {
             nthPoints.push_back(algoPoints[i]);
         }
-        auto nthResult = BezierAlgorithms::computeBezierNthOrder(nthPoints, 100, currentOrder);
+        auto nthResult = adaptive ? BezierAlgorithms::flattenAdaptive(nthPoints, kFlatnessTolerance)
+                                  : BezierAlgorithms::computeBezierNthOrder(nthPoints, 100, currentOrder);
         nthOrderCurve.clear();
         for (const auto& p : nthResult) {
             nthOrderCurve.emplace_back(p.x, p.y);
@@ -123,6 +126,8 @@ void BezierWidget::paintEvent(QPaintEvent *event) {
     painter.drawText(10, 40, QString("Квадратичная: %1").arg(showQuadratic ? "Да" : "Нет"));
     painter.drawText(10, 60, QString("Кубическая: %1").arg(showCubic ? "Да" : "Нет"));
     painter.drawText(10, 80, QString("%1-го порядка: %2").arg(currentOrder).arg(showNthOrder ? "Да" : "Нет"));
+    size_t samples = quadraticCurve.size() + cubicCurve.size() + nthOrderCurve.size();
+    painter.drawText(10, 100, QString("Отсчётов: %1 (%2)").arg(samples).arg(adaptive ? "адаптивно" : "равномерно"));
 }
 
 void BezierWidget::mousePressEvent(QMouseEvent *event) {
@@ -179,6 +184,11 @@ void BezierWidget::setShowNthOrder(bool show) {
     updateCurves();
 }
 
+void BezierWidget::setAdaptive(bool enabled) {
+    adaptive = enabled;
+    updateCurves();
+}
+
 MainWindow::MainWindow(QWidget *parent) : QWidget(parent) {
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
@@ -191,6 +201,7 @@ MainWindow::MainWindow(QWidget *parent) : QWidget(parent) {
     QCheckBox *quadraticCheck = new QCheckBox("Квадратичная (2)", this);
     QCheckBox *cubicCheck = new QCheckBox("Кубическая (3)", this);
     QCheckBox *nthOrderCheck = new QCheckBox("Высокий порядок", this);
+    QCheckBox *adaptiveCheck = new QCheckBox("Адаптивно", this);
     QLabel *orderLabel = new QLabel("Порядок:", this);
 
     quadraticCheck->setChecked(true);
@@ -201,6 +212,7 @@ MainWindow::MainWindow(QWidget *parent) : QWidget(parent) {
     controlLayout->addWidget(quadraticCheck);
     controlLayout->addWidget(cubicCheck);
     controlLayout->addWidget(nthOrderCheck);
+    controlLayout->addWidget(adaptiveCheck);
     controlLayout->addWidget(orderLabel);
 
     QPushButton *order3Btn = new QPushButton("3", this);
@@ -221,6 +233,7 @@ MainWindow::MainWindow(QWidget *parent) : QWidget(parent) {
     connect(quadraticCheck, &QCheckBox::toggled, bezierWidget, &BezierWidget::setShowQuadratic);
     connect(cubicCheck, &QCheckBox::toggled, bezierWidget, &BezierWidget::setShowCubic);
     connect(nthOrderCheck, &QCheckBox::toggled, bezierWidget, &BezierWidget::setShowNthOrder);
+    connect(adaptiveCheck, &QCheckBox::toggled, bezierWidget, &BezierWidget::setAdaptive);
 
     connect(order3Btn, &QPushButton::clicked, [this]() { bezierWidget->setOrder(3); });
     connect(order4Btn, &QPushButton::clicked, [this]() { bezierWidget->setOrder(4); });
@@ -41,12 +41,17 @@ private:
     bool showQuadratic;
     bool showCubic;
     bool showNthOrder;
+    bool adaptive;
     int currentOrder;
 
+    // Допустимое отклонение ломаной от кривой в адаптивном режиме, пиксели
+    static constexpr double kFlatnessTolerance = 0.25;
+
 public slots:
     void setShowQuadratic(bool show);
     void setShowCubic(bool show);
     void setShowNthOrder(bool show);
+    void setAdaptive(bool enabled);
 };
 
 class MainWindow : public QWidget {
@@ -0,0 +1,334 @@
+#include "polygon_collision_algorithms.h"
+#include <limits>
+
+static AlgoPoint closestOnSegment(const AlgoPoint& p, const AlgoPoint& a, const AlgoPoint& b) {
+    AlgoPoint ab = b - a;
+    double len2 = ab.dist2();
+    if (len2 < 1e-24) return a;
+    double t = std::max(0.0, std::min(1.0, (p - a).dot(ab) / len2));
+    return a + ab * t;
+}
+
+static AlgoPoint centroid(const std::vector<AlgoPoint>& points) {
+    AlgoPoint c;
+    for (const auto& p : points) c = c + p;
+    return c * (1.0 / points.size());
+}
+
+double PolygonCollision::segmentDistance2(const AlgoPoint& p, const AlgoPoint& a, const AlgoPoint& b) {
+    return (p - closestOnSegment(p, a, b)).dist2();
+}
+
+AlgoPoint PolygonCollision::support(const std::vector<AlgoPoint>& polygon, const AlgoPoint& direction) {
+    size_t best = 0;
+    double bestDot = polygon[0].dot(direction);
+    for (size_t i = 1; i < polygon.size(); i++) {
+        double d = polygon[i].dot(direction);
+        if (d > bestDot) {
+            bestDot = d;
+            best = i;
+        }
+    }
+    return polygon[best];
+}
+
+// Опорная точка разности Минковского A - B
+AlgoPoint PolygonCollision::supportDifference(const AlgoPolygon& a, const AlgoPolygon& b,
+                                              const AlgoPoint& direction) {
+    return support(a.hull(), direction) - support(b.hull(), direction * -1);
+}
+
+// Ближайшая к началу координат точка симплекса; симплекс сокращается до
+// вершин, на которых она лежит
+AlgoPoint PolygonCollision::closestOnSimplex(std::vector<AlgoPoint>& simplex, bool& containsOrigin) {
+    containsOrigin = false;
+    AlgoPoint origin;
+
+    if (simplex.size() == 1) return simplex[0];
+
+    if (simplex.size() == 2) {
+        AlgoPoint a = simplex[0];
+        AlgoPoint b = simplex[1];
+        AlgoPoint ab = b - a;
+        double len2 = ab.dist2();
+        double t = len2 < 1e-24 ? 0.0 : -a.dot(ab) / len2;
+        if (t <= 0) {
+            simplex = {a};
+            return a;
+        }
+        if (t >= 1) {
+            simplex = {b};
+            return b;
+        }
+        return a + ab * t;
+    }
+
+    const AlgoPoint& a = simplex[0];
+    const AlgoPoint& b = simplex[1];
+    const AlgoPoint& c = simplex[2];
+    double d1 = (b - a).cross(origin - a);
+    double d2 = (c - b).cross(origin - b);
+    double d3 = (a - c).cross(origin - c);
+    bool hasNeg = d1 < 0 || d2 < 0 || d3 < 0;
+    bool hasPos = d1 > 0 || d2 > 0 || d3 > 0;
+    if (!(hasNeg && hasPos)) {
+        containsOrigin = true;
+        return origin;
+    }
+
+    std::vector<AlgoPoint> best;
+    AlgoPoint bestPoint;
+    double bestDist = std::numeric_limits<double>::max();
+    const int edges[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+    for (const auto& e : edges) {
+        std::vector<AlgoPoint> edge = {simplex[e[0]], simplex[e[1]]};
+        bool unused;
+        AlgoPoint p = closestOnSimplex(edge, unused);
+        if (p.dist2() < bestDist) {
+            bestDist = p.dist2();
+            bestPoint = p;
+            best = edge;
+        }
+    }
+    simplex = best;
+    return bestPoint;
+}
+
+void PolygonCollision::expandPolytope(const AlgoPolygon& a, const AlgoPolygon& b,
+                                      std::vector<AlgoPoint> polytope, CollisionResult& result) {
+    if (PolygonOperationsAlgorithms::signedArea(polytope) < 0) {
+        std::reverse(polytope.begin(), polytope.end());
+    }
+
+    size_t maxIterations = 64 + a.size() + b.size();
+    for (size_t iteration = 0; iteration < maxIterations; iteration++) {
+        size_t bestEdge = 0;
+        double bestDist = std::numeric_limits<double>::max();
+        AlgoPoint bestNormal;
+        for (size_t i = 0; i < polytope.size(); i++) {
+            AlgoPoint e = polytope[(i + 1) % polytope.size()] - polytope[i];
+            double len = std::sqrt(e.dist2());
+            if (len < 1e-18) continue;
+            AlgoPoint normal(e.y / len, -e.x / len);
+            double dist = normal.dot(polytope[i]);
+            if (dist < bestDist) {
+                bestDist = dist;
+                bestEdge = i;
+                bestNormal = normal;
+            }
+        }
+
+        AlgoPoint s = supportDifference(a, b, bestNormal);
+        if (s.dot(bestNormal) - bestDist <= 1e-9 * std::max(1.0, std::abs(bestDist))) {
+            result.penetration = bestDist;
+            result.normal = bestNormal;
+            return;
+        }
+        polytope.insert(polytope.begin() + bestEdge + 1, s);
+    }
+}
+
+CollisionResult PolygonCollision::collideGJK(const AlgoPolygon& a, const AlgoPolygon& b) {
+    CollisionResult result;
+    if (a.empty() || b.empty()) return result;
+
+    AlgoPoint direction = centroid(a.hull()) - centroid(b.hull());
+    if (direction.dist2() < 1e-24) direction = AlgoPoint(1, 0);
+
+    std::vector<AlgoPoint> simplex = {supportDifference(a, b, direction)};
+    AlgoPoint v = simplex[0];
+    bool containsOrigin = false;
+
+    size_t maxIterations = 64 + a.size() + b.size();
+    for (size_t iteration = 0; iteration < maxIterations; iteration++) {
+        double v2 = v.dist2();
+        if (v2 < 1e-24) break;
+
+        AlgoPoint w = supportDifference(a, b, v * -1);
+        if (v2 - v.dot(w) <= 1e-10 * v2) {
+            double dist = std::sqrt(v2);
+            result.distance = dist;
+            result.normal = v * (-1.0 / dist);
+            return result;
+        }
+        simplex.push_back(w);
+        v = closestOnSimplex(simplex, containsOrigin);
+        if (containsOrigin) break;
+    }
+
+    result.colliding = true;
+    if (containsOrigin && simplex.size() == 3) {
+        expandPolytope(a, b, simplex, result);
+        return result;
+    }
+    // Начало координат на границе симплекса — касание, глубину считает SAT
+    return collideSAT(a, b);
+}
+
+CollisionResult PolygonCollision::collideSAT(const AlgoPolygon& a, const AlgoPolygon& b) {
+    CollisionResult result;
+    if (a.empty() || b.empty()) return result;
+
+    double minOverlap = std::numeric_limits<double>::max();
+    AlgoPoint minAxis;
+    bool separated = false;
+
+    const std::vector<AlgoPoint>& hullA = a.hull();
+    const std::vector<AlgoPoint>& hullB = b.hull();
+    const std::vector<AlgoPoint>* polygons[2] = {&hullA, &hullB};
+    for (const auto* poly : polygons) {
+        for (size_t i = 0; i < poly->size() && !separated; i++) {
+            AlgoPoint e = (*poly)[(i + 1) % poly->size()] - (*poly)[i];
+            double len = std::sqrt(e.dist2());
+            if (len < 1e-18) continue;
+            AlgoPoint axis(-e.y / len, e.x / len);
+
+            double minA = std::numeric_limits<double>::max(), maxA = -minA;
+            double minB = minA, maxB = -minA;
+            for (const auto& p : hullA) {
+                minA = std::min(minA, p.dot(axis));
+                maxA = std::max(maxA, p.dot(axis));
+            }
+            for (const auto& p : hullB) {
+                minB = std::min(minB, p.dot(axis));
+                maxB = std::max(maxB, p.dot(axis));
+            }
+
+            // Сдвиг B вдоль оси в положительную или отрицательную сторону
+            double forward = maxA - minB;
+            double backward = maxB - minA;
+            if (forward < 0 || backward < 0) {
+                separated = true;
+                break;
+            }
+            double overlap = std::min(forward, backward);
+            if (overlap < minOverlap) {
+                minOverlap = overlap;
+                minAxis = forward < backward ? axis : axis * -1;
+            }
+        }
+    }
+
+    if (!separated) {
+        result.colliding = true;
+        result.penetration = minOverlap;
+        result.normal = minAxis;
+        return result;
+    }
+
+    // Расстояние между непересекающимися многоугольниками достигается на паре
+    // вершина — ребро
+    double bestDist2 = std::numeric_limits<double>::max();
+    AlgoPoint fromA, toB;
+    for (int side = 0; side < 2; side++) {
+        const auto& vertices = side == 0 ? hullA : hullB;
+        const auto& edges = side == 0 ? hullB : hullA;
+        for (const auto& p : vertices) {
+            for (size_t i = 0; i < edges.size(); i++) {
+                AlgoPoint q = closestOnSegment(p, edges[i], edges[(i + 1) % edges.size()]);
+                double d2 = (p - q).dist2();
+                if (d2 < bestDist2) {
+                    bestDist2 = d2;
+                    fromA = side == 0 ? p : q;
+                    toB = side == 0 ? q : p;
+                }
+            }
+        }
+    }
+    result.distance = std::sqrt(bestDist2);
+    if (result.distance > 0) result.normal = (toB - fromA) * (1.0 / result.distance);
+    return result;
+}
+
+CollisionResult PolygonCollision::collide(const AlgoPolygon& a, const AlgoPolygon& b) {
+    if (a.hull().size() <= kSatVertexLimit && b.hull().size() <= kSatVertexLimit) return collideSAT(a, b);
+    return collideGJK(a, b);
+}
+
+void CollisionWorld::updateBounds(Body& body) {
+    const AlgoBounds& bounds = body.polygon.bounds();
+    body.minX = bounds.minX;
+    body.minY = bounds.minY;
+    body.maxX = bounds.maxX;
+    body.maxY = bounds.maxY;
+}
+
+size_t CollisionWorld::addPolygon(const AlgoPolygon& polygon) {
+    Body body;
+    body.polygon = polygon;
+    updateBounds(body);
+    bodies.push_back(body);
+
+    size_t id = bodies.size() - 1;
+    endpoints.push_back({id, true, body.minX});
+    endpoints.push_back({id, false, body.maxX});
+    return id;
+}
+
+void CollisionWorld::setPolygon(size_t id, const AlgoPolygon& polygon) {
+    bodies[id].polygon = polygon;
+    updateBounds(bodies[id]);
+}
+
+void CollisionWorld::clear() {
+    bodies.clear();
+    endpoints.clear();
+    candidates.clear();
+}
+
+const std::vector<std::pair<size_t, size_t>>& CollisionWorld::updateBroadphase() {
+    for (auto& e : endpoints) {
+        e.value = e.isMin ? bodies[e.body].minX : bodies[e.body].maxX;
+    }
+
+    // Порядок с прошлого кадра почти верный, сортировка вставками здесь близка к O(n).
+    // При равных значениях начало интервала идёт раньше конца, касание считается пересечением.
+    auto before = [](const Endpoint& a, const Endpoint& b) {
+        if (a.value != b.value) return a.value < b.value;
+        return a.isMin && !b.isMin;
+    };
+    for (size_t i = 1; i < endpoints.size(); i++) {
+        Endpoint e = endpoints[i];
+        size_t j = i;
+        while (j > 0 && before(e, endpoints[j - 1])) {
+            endpoints[j] = endpoints[j - 1];
+            j--;
+        }
+        endpoints[j] = e;
+    }
+
+    candidates.clear();
+    std::vector<size_t> active;
+    std::vector<size_t> activePos(bodies.size(), 0);
+    for (const auto& e : endpoints) {
+        const Body& body = bodies[e.body];
+        if (e.isMin) {
+            for (size_t other : active) {
+                const Body& o = bodies[other];
+                if (o.maxY < body.minY || body.maxY < o.minY) continue;
+                candidates.push_back(std::make_pair(std::min(other, e.body), std::max(other, e.body)));
+            }
+            activePos[e.body] = active.size();
+            active.push_back(e.body);
+        } else {
+            size_t pos = activePos[e.body];
+            activePos[active.back()] = pos;
+            active[pos] = active.back();
+            active.pop_back();
+        }
+    }
+    return candidates;
+}
+
+std::vector<CollisionPair> CollisionWorld::findCollisions() {
+    updateBroadphase();
+
+    std::vector<CollisionPair> result;
+    result.reserve(candidates.size());
+    for (const auto& c : candidates) {
+        CollisionPair pair(c.first, c.second);
+        pair.result = PolygonCollision::collide(bodies[c.first].polygon, bodies[c.second].polygon);
+        result.push_back(pair);
+    }
+    return result;
+}
@@ -0,0 +1,80 @@
+#ifndef POLYGON_COLLISION_ALGORITHMS_H
+#define POLYGON_COLLISION_ALGORITHMS_H
+
+#include <utility>
+#include <vector>
+#include "polygon_ops_algorithms.h"
+
+struct CollisionResult {
+    bool colliding;
+    double distance;      // расстояние между многоугольниками, если они не пересекаются
+    double penetration;   // глубина проникновения, если пересекаются
+    AlgoPoint normal;     // единичный вектор от первого многоугольника ко второму
+
+    CollisionResult() : colliding(false), distance(0), penetration(0) {}
+};
+
+struct CollisionPair {
+    size_t first, second;
+    CollisionResult result;
+    CollisionPair(size_t first = 0, size_t second = 0) : first(first), second(second) {}
+};
+
+// Точная проверка пары выпуклых многоугольников (для невыпуклых берутся
+// кешированные оболочки). Для маленьких многоугольников
+// используется теорема о разделяющей оси, для больших — GJK, а при пересечении
+// глубина проникновения уточняется алгоритмом EPA.
+class PolygonCollision {
+public:
+    static constexpr size_t kSatVertexLimit = 16;
+
+    static CollisionResult collide(const AlgoPolygon& a, const AlgoPolygon& b);
+    static CollisionResult collideSAT(const AlgoPolygon& a, const AlgoPolygon& b);
+    static CollisionResult collideGJK(const AlgoPolygon& a, const AlgoPolygon& b);
+
+private:
+    static AlgoPoint support(const std::vector<AlgoPoint>& polygon, const AlgoPoint& direction);
+    static AlgoPoint supportDifference(const AlgoPolygon& a, const AlgoPolygon& b, const AlgoPoint& direction);
+    static AlgoPoint closestOnSimplex(std::vector<AlgoPoint>& simplex, bool& containsOrigin);
+    static void expandPolytope(const AlgoPolygon& a, const AlgoPolygon& b,
+                               std::vector<AlgoPoint> polytope, CollisionResult& result);
+    static double segmentDistance2(const AlgoPoint& p, const AlgoPoint& a, const AlgoPoint& b);
+};
+
+// Сцена из многих многоугольников. Широкая фаза — sweep-and-prune по
+// x-интервалам: отсортированный список концов интервалов хранится между кадрами
+// и досортировывается вставками, поэтому при малых перемещениях обновление почти
+// линейное. Узкая фаза вызывается только для пар с пересекающимися AABB.
+class CollisionWorld {
+public:
+    size_t addPolygon(const AlgoPolygon& polygon);
+    void setPolygon(size_t id, const AlgoPolygon& polygon);
+    const AlgoPolygon& polygon(size_t id) const { return bodies[id].polygon; }
+    size_t size() const { return bodies.size(); }
+    void clear();
+
+    // Пары (first < second) с пересекающимися AABB
+    const std::vector<std::pair<size_t, size_t>>& updateBroadphase();
+    // Результаты узкой фазы для всех пар широкой фазы
+    std::vector<CollisionPair> findCollisions();
+
+private:
+    struct Body {
+        AlgoPolygon polygon;
+        double minX, minY, maxX, maxY;
+    };
+
+    struct Endpoint {
+        size_t body;
+        bool isMin;
+        double value;
+    };
+
+    static void updateBounds(Body& body);
+
+    std::vector<Body> bodies;
+    std::vector<Endpoint> endpoints;
+    std::vector<std::pair<size_t, size_t>> candidates;
+};
+
+#endif
@@ -0,0 +1,200 @@
+#include "polygon_distance_algorithms.h"
+#include <limits>
+
+std::vector<ConvexPolygonDistance::DifferenceVertex> ConvexPolygonDistance::minkowskiDifference(
+    const std::vector<AlgoPoint>& a, const std::vector<AlgoPoint>& b) {
+    // -B тоже обходится против часовой стрелки, а её нижняя вершина — верхняя вершина B
+    size_t m = b.size();
+    size_t top = 0;
+    for (size_t j = 1; j < m; j++) {
+        if (b[j].y > b[top].y || (b[j].y == b[top].y && b[j].x > b[top].x)) top = j;
+    }
+
+    size_t n = a.size();
+    std::vector<DifferenceVertex> result;
+    result.reserve(n + m);
+    size_t i = 0, j = 0;
+    while (i < n || j < m) {
+        size_t ia = i % n;
+        size_t ib = (top + j) % m;
+        size_t nextA = (i + 1) % n;
+        size_t nextB = (top + j + 1) % m;
+        result.push_back({a[ia] - b[ib], ia, ib});
+
+        double cross = (a[nextA] - a[ia]).cross(b[ib] - b[nextB]);
+        if (cross >= 0 && i < n) i++;
+        if (cross <= 0 && j < m) j++;
+    }
+    return result;
+}
+
+SeparationResult ConvexPolygonDistance::separation(const AlgoPolygon& a, const AlgoPolygon& b) {
+    SeparationResult result;
+    if (a.empty() || b.empty()) return result;
+
+    const std::vector<AlgoPoint>& hullA = a.hull();
+    const std::vector<AlgoPoint>& hullB = b.hull();
+    std::vector<DifferenceVertex> diff = minkowskiDifference(hullA, hullB);
+    size_t k = diff.size();
+
+    // Начало координат внутри A - B, если оно слева от всех рёбер
+    bool inside = k >= 3;
+    double bestDist2 = std::numeric_limits<double>::max();
+    double minEdgeDist = std::numeric_limits<double>::max();
+    size_t bestEdge = 0;
+    double bestT = 0;
+    AlgoPoint bestNormal;
+    for (size_t e = 0; e < k; e++) {
+        const AlgoPoint& p = diff[e].p;
+        AlgoPoint d = diff[(e + 1) % k].p - p;
+        double len2 = d.dist2();
+
+        double t = len2 > 0 ? std::max(0.0, std::min(1.0, -p.dot(d) / len2)) : 0.0;
+        double dist2 = (p + d * t).dist2();
+        if (dist2 < bestDist2) {
+            bestDist2 = dist2;
+            bestEdge = e;
+            bestT = t;
+        }
+
+        if (len2 > 0) {
+            double len = std::sqrt(len2);
+            AlgoPoint normal(d.y / len, -d.x / len);
+            double lineDist = normal.dot(p);
+            if (lineDist < 0) inside = false;
+            if (lineDist < minEdgeDist) {
+                minEdgeDist = lineDist;
+                bestNormal = normal;
+            }
+        }
+    }
+
+    const DifferenceVertex& from = diff[bestEdge];
+    const DifferenceVertex& to = diff[(bestEdge + 1) % k];
+    result.closestA = hullA[from.indexA] + (hullA[to.indexA] - hullA[from.indexA]) * bestT;
+    result.closestB = hullB[from.indexB] + (hullB[to.indexB] - hullB[from.indexB]) * bestT;
+
+    if (inside) {
+        result.penetration = minEdgeDist;
+        result.axis = bestNormal;
+        return result;
+    }
+
+    result.separated = bestDist2 > 0;
+    result.distance = std::sqrt(bestDist2);
+    if (result.separated) result.axis = (result.closestB - result.closestA) * (1.0 / result.distance);
+    return result;
+}
+
+double ConvexPolygonDistance::minimumDistance(const AlgoPolygon& a, const AlgoPolygon& b) {
+    return separation(a, b).distance;
+}
+
+// Двоичный поиск клина веера из hull[0]. Для внешней точки edge — ребро,
+// видимое из неё, с него начинается поиск ближайшего ребра.
+bool ConvexPolygonDistance::locateConvex(const std::vector<AlgoPoint>& hull, const AlgoPoint& p, size_t& edge) {
+    size_t n = hull.size();
+    edge = 0;
+    if (n < 3) return false;
+
+    const AlgoPoint& apex = hull[0];
+    AlgoPoint rel = p - apex;
+    if ((hull[1] - apex).cross(rel) < 0) return false;
+    if ((hull[n - 1] - apex).cross(rel) > 0) {
+        edge = n - 1;
+        return false;
+    }
+
+    size_t lo = 1, hi = n - 1;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if ((hull[mid] - apex).cross(rel) >= 0) lo = mid;
+        else hi = mid;
+    }
+    edge = lo;
+    return (hull[lo + 1] - hull[lo]).cross(p - hull[lo]) >= 0;
+}
+
+double ConvexPolygonDistance::edgeDistance2(const std::vector<AlgoPoint>& hull, size_t edge, const AlgoPoint& p) {
+    const AlgoPoint& a = hull[edge];
+    AlgoPoint d = hull[(edge + 1) % hull.size()] - a;
+    double len2 = d.dist2();
+    double t = len2 > 0 ? std::max(0.0, std::min(1.0, (p - a).dot(d) / len2)) : 0.0;
+    return (p - (a + d * t)).dist2();
+}
+
+// Максимум расстояния до выпуклого многоугольника достигается в вершине.
+// На цепочке рёбер, видимых из внешней точки, расстояние сначала убывает,
+// а потом растёт, поэтому ближайшее ребро находится спуском по этой цепочке
+// от любого видимого.
+// Спуск начинается с ответа для предыдущей вершины: соседние вершины
+// проецируются на близкие рёбра, и шаги в сумме дают O(n + m). Если это ребро
+// не видно, опорой служит ребро из двоичного поиска, O(log m).
+double ConvexPolygonDistance::directedHausdorff(const std::vector<AlgoPoint>& from,
+                                                const std::vector<AlgoPoint>& to) {
+    size_t m = to.size();
+    if (from.empty() || m == 0) return 0;
+
+    double worst2 = 0;
+    bool havePrevious = false;
+    size_t previous = 0;
+    for (const auto& p : from) {
+        size_t edge;
+        if (locateConvex(to, p, edge)) continue;
+
+        if (havePrevious && m >= 3) {
+            const AlgoPoint& a = to[previous];
+            if ((to[(previous + 1) % m] - a).cross(p - a) < 0) edge = previous;
+        }
+
+        // Спуск не выходит за видимую цепочку: на обратной стороне тонкой
+        // оболочки расстояние снова убывает, и там есть ложный минимум
+        auto visible = [&](size_t e) { return (to[(e + 1) % m] - to[e]).cross(p - to[e]) < 0; };
+        double best = edgeDistance2(to, edge, p);
+        for (size_t step = 0; step < m; step++) {
+            size_t next = (edge + 1) % m;
+            if (!visible(next)) break;
+            double d = edgeDistance2(to, next, p);
+            if (d >= best) break;
+            best = d;
+            edge = next;
+        }
+        for (size_t step = 0; step < m; step++) {
+            size_t prev = (edge + m - 1) % m;
+            if (!visible(prev)) break;
+            double d = edgeDistance2(to, prev, p);
+            if (d >= best) break;
+            best = d;
+            edge = prev;
+        }
+        worst2 = std::max(worst2, best);
+        previous = edge;
+        havePrevious = true;
+    }
+    return std::sqrt(worst2);
+}
+
+double ConvexPolygonDistance::hausdorffDistance(const AlgoPolygon& a, const AlgoPolygon& b) {
+    if (a.empty() || b.empty()) return 0;
+    return std::max(directedHausdorff(a.hull(), b.hull()), directedHausdorff(b.hull(), a.hull()));
+}
+
+std::vector<SeparationResult> ConvexPolygonDistance::separations(
+    const std::vector<AlgoPolygon>& polygons, const std::vector<std::pair<size_t, size_t>>& pairs) {
+    std::vector<SeparationResult> result;
+    result.reserve(pairs.size());
+    for (const auto& pair : pairs) {
+        result.push_back(separation(polygons[pair.first], polygons[pair.second]));
+    }
+    return result;
+}
+
+std::vector<double> ConvexPolygonDistance::hausdorffDistances(
+    const std::vector<AlgoPolygon>& polygons, const std::vector<std::pair<size_t, size_t>>& pairs) {
+    std::vector<double> result;
+    result.reserve(pairs.size());
+    for (const auto& pair : pairs) {
+        result.push_back(hausdorffDistance(polygons[pair.first], polygons[pair.second]));
+    }
+    return result;
+}
@@ -0,0 +1,50 @@
+#ifndef POLYGON_DISTANCE_ALGORITHMS_H
+#define POLYGON_DISTANCE_ALGORITHMS_H
+
+#include <utility>
+#include <vector>
+#include "polygon_ops_algorithms.h"
+
+struct SeparationResult {
+    bool separated;
+    double distance;      // минимальное расстояние, 0 при пересечении
+    double penetration;   // глубина пересечения, 0 если многоугольники разделены
+    AlgoPoint closestA, closestB;
+    // Единичная разделяющая ось от A к B; при пересечении — направление,
+    // в котором B нужно сдвинуть на penetration
+    AlgoPoint axis;
+
+    SeparationResult() : separated(false), distance(0), penetration(0) {}
+};
+
+// Расстояния между выпуклыми оболочками многоугольников. Вращающиеся калиперы
+// реализованы как слияние рёбер A и -B по углу: получается разность Минковского
+// A - B за O(n + m), и расстояние между A и B равно расстоянию от начала
+// координат до неё.
+class ConvexPolygonDistance {
+public:
+    static SeparationResult separation(const AlgoPolygon& a, const AlgoPolygon& b);
+    static double minimumDistance(const AlgoPolygon& a, const AlgoPolygon& b);
+    // Симметричное расстояние Хаусдорфа max(h(A, B), h(B, A))
+    static double hausdorffDistance(const AlgoPolygon& a, const AlgoPolygon& b);
+
+    static std::vector<SeparationResult> separations(const std::vector<AlgoPolygon>& polygons,
+                                                     const std::vector<std::pair<size_t, size_t>>& pairs);
+    static std::vector<double> hausdorffDistances(const std::vector<AlgoPolygon>& polygons,
+                                                  const std::vector<std::pair<size_t, size_t>>& pairs);
+
+private:
+    // Вершина разности Минковского и индексы вершин A и B, из которых она получена
+    struct DifferenceVertex {
+        AlgoPoint p;
+        size_t indexA, indexB;
+    };
+
+    static std::vector<DifferenceVertex> minkowskiDifference(const std::vector<AlgoPoint>& a,
+                                                             const std::vector<AlgoPoint>& b);
+    static double directedHausdorff(const std::vector<AlgoPoint>& from, const std::vector<AlgoPoint>& to);
+    static bool locateConvex(const std::vector<AlgoPoint>& hull, const AlgoPoint& p, size_t& edge);
+    static double edgeDistance2(const std::vector<AlgoPoint>& hull, size_t edge, const AlgoPoint& p);
+};
+
+#endif
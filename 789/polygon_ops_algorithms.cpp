@@ -1,7 +1,14 @@
 #include "polygon_ops_algorithms.h"
+#include "point_hash_grid.h"
 
-void AlgoPolygon::computeConvexHull() {
-    if (points.size() < 3) return;
+std::vector<AlgoPoint> AlgoPolygon::buildHull(std::vector<AlgoPoint> points) {
+    if (points.size() < 3) {
+        if (points.size() == 2 && (points[1].y < points[0].y ||
+                                   (points[1].y == points[0].y && points[1].x < points[0].x))) {
+            std::swap(points[0], points[1]);
+        }
+        return points;
+    }
 
     int n = points.size();
     int minIdx = 0;
@@ -41,7 +48,72 @@ void AlgoPolygon::computeConvexHull() {
         hull.push_back(points[i]);
     }
 
-    points = hull;
+    return hull;
+}
+
+void AlgoPolygon::update() const {
+    if (!dirty) return;
+
+    cachedHull = buildHull(sourcePoints);
+    cachedBounds = AlgoBounds();
+    cachedArea = 0;
+    cachedConvex = sourcePoints.size() >= 3;
+
+    if (!sourcePoints.empty()) {
+        cachedBounds.minX = cachedBounds.maxX = sourcePoints[0].x;
+        cachedBounds.minY = cachedBounds.maxY = sourcePoints[0].y;
+    }
+    int turn = 0;
+    size_t n = sourcePoints.size();
+    for (size_t i = 0; i < n; i++) {
+        const AlgoPoint& a = sourcePoints[i];
+        const AlgoPoint& b = sourcePoints[(i + 1) % n];
+        const AlgoPoint& c = sourcePoints[(i + 2) % n];
+        cachedBounds.minX = std::min(cachedBounds.minX, a.x);
+        cachedBounds.minY = std::min(cachedBounds.minY, a.y);
+        cachedBounds.maxX = std::max(cachedBounds.maxX, a.x);
+        cachedBounds.maxY = std::max(cachedBounds.maxY, a.y);
+        cachedArea += a.cross(b);
+
+        double cross = (b - a).cross(c - b);
+        if (std::abs(cross) > 1e-12) {
+            int sign = cross > 0 ? 1 : -1;
+            if (turn != 0 && sign != turn) cachedConvex = false;
+            turn = sign;
+        }
+    }
+    cachedArea /= 2.0;
+    // Все повороты в одну сторону ещё допускают самопересечение (звезда),
+    // поэтому выпуклый контур дополнительно должен совпадать с оболочкой по площади
+    if (cachedConvex) {
+        double hullArea = PolygonOperationsAlgorithms::signedArea(cachedHull);
+        cachedConvex = std::abs(std::abs(cachedArea) - hullArea) <= 1e-9 * std::max(1.0, hullArea);
+    }
+    dirty = false;
+}
+
+const std::vector<AlgoPoint>& AlgoPolygon::hull() const {
+    update();
+    return cachedHull;
+}
+
+const AlgoBounds& AlgoPolygon::bounds() const {
+    update();
+    return cachedBounds;
+}
+
+double AlgoPolygon::area() const {
+    update();
+    return cachedArea;
+}
+
+bool AlgoPolygon::isConvex() const {
+    update();
+    return cachedConvex;
+}
+
+void AlgoPolygon::computeConvexHull() {
+    setPoints(hull());
 }
 
 AlgoPolygon PolygonOperationsAlgorithms::computeOperation(const AlgoPolygon& poly1, const AlgoPolygon& poly2, Operation op) {
@@ -58,17 +130,18 @@ AlgoPolygon PolygonOperationsAlgorithms::computeOperation(const AlgoPolygon& pol
 
 AlgoPolygon PolygonOperationsAlgorithms::computeIntersection(const AlgoPolygon& poly1, const AlgoPolygon& poly2) {
     AlgoPolygon result;
-    std::vector<AlgoPoint> points1 = poly1.points;
-    std::vector<AlgoPoint> points2 = poly2.points;
+    const std::vector<AlgoPoint>& points1 = poly1.hull();
+    const std::vector<AlgoPoint>& points2 = poly2.hull();
+    PointHashGrid<AlgoPoint> uniquePoints(1e-9, points1.size() + points2.size());
 
     for (const auto& p : points1) {
-        if (isPointInsidePolygon(p, points2)) {
+        if (isPointInsidePolygon(p, points2) && uniquePoints.insert(p)) {
             result.addPoint(p);
         }
     }
 
     for (const auto& p : points2) {
-        if (isPointInsidePolygon(p, points1)) {
+        if (isPointInsidePolygon(p, points1) && uniquePoints.insert(p)) {
             result.addPoint(p);
         }
     }
@@ -80,7 +153,8 @@ AlgoPolygon PolygonOperationsAlgorithms::computeIntersection(const AlgoPolygon&
 
             AlgoPoint intersect;
             if (lineSegmentIntersection(points1[i], points1[next_i],
-                                        points2[j], points2[next_j], intersect)) {
+                                        points2[j], points2[next_j], intersect) &&
+                uniquePoints.insert(intersect)) {
                 result.addPoint(intersect);
             }
         }
@@ -95,11 +169,14 @@ AlgoPolygon PolygonOperationsAlgorithms::computeIntersection(const AlgoPolygon&
 AlgoPolygon PolygonOperationsAlgorithms::computeUnion(const AlgoPolygon& poly1, const AlgoPolygon& poly2) {
     AlgoPolygon result;
     std::vector<AlgoPoint> allPoints;
-    allPoints.insert(allPoints.end(), poly1.points.begin(), poly1.points.end());
-    allPoints.insert(allPoints.end(), poly2.points.begin(), poly2.points.end());
+    allPoints.insert(allPoints.end(), poly1.hull().begin(), poly1.hull().end());
+    allPoints.insert(allPoints.end(), poly2.hull().begin(), poly2.hull().end());
+    PointHashGrid<AlgoPoint> uniquePoints(1e-9, allPoints.size());
 
     for (const auto& p : allPoints) {
-        result.addPoint(p);
+        if (uniquePoints.insert(p)) {
+            result.addPoint(p);
+        }
     }
 
     if (!result.empty()) {
@@ -110,11 +187,12 @@ AlgoPolygon PolygonOperationsAlgorithms::computeUnion(const AlgoPolygon& poly1,
 
 AlgoPolygon PolygonOperationsAlgorithms::computeDifference(const AlgoPolygon& poly1, const AlgoPolygon& poly2) {
     AlgoPolygon result;
-    std::vector<AlgoPoint> points1 = poly1.points;
-    std::vector<AlgoPoint> points2 = poly2.points;
+    const std::vector<AlgoPoint>& points1 = poly1.hull();
+    const std::vector<AlgoPoint>& points2 = poly2.hull();
+    PointHashGrid<AlgoPoint> uniquePoints(1e-9, points1.size() * 2);
 
     for (const auto& p : points1) {
-        if (!isPointInsidePolygon(p, points2)) {
+        if (!isPointInsidePolygon(p, points2) && uniquePoints.insert(p)) {
             result.addPoint(p);
         }
     }
@@ -126,7 +204,8 @@ AlgoPolygon PolygonOperationsAlgorithms::computeDifference(const AlgoPolygon& po
 
             AlgoPoint intersect;
             if (lineSegmentIntersection(points1[i], points1[next_i],
-                                        points2[j], points2[next_j], intersect)) {
+                                        points2[j], points2[next_j], intersect) &&
+                uniquePoints.insert(intersect)) {
                 result.addPoint(intersect);
             }
         }
@@ -138,6 +217,307 @@ AlgoPolygon PolygonOperationsAlgorithms::computeDifference(const AlgoPolygon& po
     return result;
 }
 
+double PolygonOperationsAlgorithms::signedArea(const std::vector<AlgoPoint>& polygon) {
+    double area = 0;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        area += polygon[j].cross(polygon[i]);
+    }
+    return area / 2.0;
+}
+
+// Кандидаты в пересечения отбираются заметанием по x: рёбра обоих многоугольников
+// сортируются по левому концу, и ребро проверяется только с активными рёбрами
+// другого многоугольника, чьи x-проекции ещё не закончились.
+// false, если найден вырожденный случай и нужен сдвиг.
+bool PolygonOperationsAlgorithms::findCrossings(const std::vector<AlgoPoint>& subject,
+                                                const std::vector<AlgoPoint>& clip,
+                                                std::vector<EdgeCrossing>& crossings) {
+    const double eps = 1e-9;
+    crossings.clear();
+
+    struct SweepEdge {
+        double minX, maxX, minY, maxY;
+        int polygon, index;
+    };
+    std::vector<SweepEdge> edges;
+    edges.reserve(subject.size() + clip.size());
+    const std::vector<AlgoPoint>* polygons[2] = {&subject, &clip};
+    for (int k = 0; k < 2; k++) {
+        const auto& poly = *polygons[k];
+        for (size_t i = 0; i < poly.size(); i++) {
+            const AlgoPoint& a = poly[i];
+            const AlgoPoint& b = poly[(i + 1) % poly.size()];
+            edges.push_back({std::min(a.x, b.x), std::max(a.x, b.x),
+                             std::min(a.y, b.y), std::max(a.y, b.y), k, static_cast<int>(i)});
+        }
+    }
+    std::sort(edges.begin(), edges.end(),
+              [](const SweepEdge& a, const SweepEdge& b) { return a.minX < b.minX; });
+
+    std::vector<const SweepEdge*> active[2];
+    for (const auto& edge : edges) {
+        auto& others = active[1 - edge.polygon];
+        size_t kept = 0;
+        for (size_t k = 0; k < others.size(); k++) {
+            const SweepEdge* other = others[k];
+            if (other->maxX < edge.minX) continue;
+            others[kept++] = other;
+            if (other->maxY < edge.minY || edge.maxY < other->minY) continue;
+
+            const SweepEdge* s = edge.polygon == 0 ? &edge : other;
+            const SweepEdge* c = edge.polygon == 0 ? other : &edge;
+            const AlgoPoint& a1 = subject[s->index];
+            const AlgoPoint& a2 = subject[(s->index + 1) % subject.size()];
+            const AlgoPoint& b1 = clip[c->index];
+            const AlgoPoint& b2 = clip[(c->index + 1) % clip.size()];
+
+            AlgoPoint d1 = a2 - a1;
+            AlgoPoint d2 = b2 - b1;
+            AlgoPoint w = b1 - a1;
+            double cross = d1.cross(d2);
+            double scale = std::sqrt(d1.dist2() * d2.dist2());
+            if (std::abs(cross) <= eps * scale) {
+                // Параллельные рёбра на одной прямой с общим участком — вырожденный случай
+                if (std::abs(d1.cross(w)) <= eps * std::sqrt(d1.dist2()) * std::sqrt(w.dist2() + d1.dist2())) {
+                    double len2 = d1.dist2();
+                    double t0 = w.dot(d1) / len2;
+                    double t1 = (b2 - a1).dot(d1) / len2;
+                    if (std::max(t0, t1) >= -eps && std::min(t0, t1) <= 1 + eps) return false;
+                }
+                continue;
+            }
+
+            double t = w.cross(d2) / cross;
+            double u = w.cross(d1) / cross;
+            if (t < -eps || t > 1 + eps || u < -eps || u > 1 + eps) continue;
+            if (t <= eps || t >= 1 - eps || u <= eps || u >= 1 - eps) return false;
+
+            crossings.push_back({s->index, c->index, t, u, a1 + d1 * t});
+        }
+        others.resize(kept);
+        active[edge.polygon].push_back(&edge);
+    }
+    return true;
+}
+
+std::vector<PolygonOperationsAlgorithms::ClipNode> PolygonOperationsAlgorithms::buildNodeList(
+    const std::vector<AlgoPoint>& polygon, const std::vector<EdgeCrossing>& crossings, bool first,
+    std::vector<int>& crossingNode) {
+    int n = static_cast<int>(polygon.size());
+    std::vector<ClipNode> nodes;
+    nodes.reserve(n + crossings.size());
+    for (int i = 0; i < n; i++) nodes.push_back(ClipNode(polygon[i]));
+
+    // Пересечения на каждом ребре упорядочиваются по параметру вдоль ребра
+    std::vector<std::vector<int>> onEdge(n);
+    crossingNode.assign(crossings.size(), -1);
+    for (size_t k = 0; k < crossings.size(); k++) {
+        const EdgeCrossing& c = crossings[k];
+        crossingNode[k] = static_cast<int>(nodes.size());
+        nodes.push_back(ClipNode(c.p, first ? c.alpha1 : c.alpha2, true));
+        onEdge[first ? c.edge1 : c.edge2].push_back(crossingNode[k]);
+    }
+
+    int last = -1;
+    auto link = [&nodes, &last](int node) {
+        if (last >= 0) {
+            nodes[last].next = node;
+            nodes[node].prev = last;
+        }
+        last = node;
+    };
+    for (int i = 0; i < n; i++) {
+        link(i);
+        auto& list = onEdge[i];
+        std::sort(list.begin(), list.end(),
+                  [&nodes](int a, int b) { return nodes[a].alpha < nodes[b].alpha; });
+        for (int node : list) link(node);
+    }
+    nodes[last].next = 0;
+    nodes[0].prev = last;
+    return nodes;
+}
+
+// Флаг entry: входит ли контур в другой многоугольник в этой точке. Для
+// объединения и разности флаги инвертируются, что меняет направление обхода.
+void PolygonOperationsAlgorithms::markEntries(std::vector<ClipNode>& nodes, const std::vector<AlgoPoint>& other,
+                                              bool invert) {
+    bool inside = isPointInsidePolygon(nodes[0].p, other);
+    int node = 0;
+    do {
+        if (nodes[node].intersection) {
+            nodes[node].entry = !inside != invert;
+            inside = !inside;
+        }
+        node = nodes[node].next;
+    } while (node != 0);
+}
+
+std::vector<AlgoPolygon> PolygonOperationsAlgorithms::traverse(std::vector<ClipNode>& subject,
+                                                               std::vector<ClipNode>& clip) {
+    std::vector<AlgoPolygon> result;
+    std::vector<ClipNode>* lists[2] = {&subject, &clip};
+
+    // Обход начинается только с точек входа: тогда первый многоугольник
+    // проходится вперёд, и контуры получаются с единой ориентацией
+    for (size_t start = 0; start < subject.size(); start++) {
+        if (!subject[start].intersection || !subject[start].entry || subject[start].visited) continue;
+
+        AlgoPolygon contour;
+        int list = 0;
+        int node = static_cast<int>(start);
+        while (!(*lists[list])[node].visited) {
+            ClipNode& current = (*lists[list])[node];
+            current.visited = true;
+            (*lists[1 - list])[current.neighbor].visited = true;
+            contour.addPoint(current.p);
+
+            bool forward = current.entry;
+            do {
+                node = forward ? (*lists[list])[node].next : (*lists[list])[node].prev;
+                if (!(*lists[list])[node].intersection) contour.addPoint((*lists[list])[node].p);
+            } while (!(*lists[list])[node].intersection);
+
+            node = (*lists[list])[node].neighbor;
+            list = 1 - list;
+        }
+        if (contour.size() >= 3) result.push_back(contour);
+    }
+    return result;
+}
+
+std::vector<AlgoPolygon> PolygonOperationsAlgorithms::disjointResult(const std::vector<AlgoPoint>& subject,
+                                                                     const std::vector<AlgoPoint>& clip,
+                                                                     Operation op) {
+    AlgoPolygon first(subject);
+    AlgoPolygon second(clip);
+    bool subjectInClip = isPointInsidePolygon(subject[0], clip);
+    bool clipInSubject = isPointInsidePolygon(clip[0], subject);
+
+    std::vector<AlgoPolygon> result;
+    switch (op) {
+    case INTERSECTION:
+        if (subjectInClip) result.push_back(first);
+        else if (clipInSubject) result.push_back(second);
+        break;
+    case UNION:
+        if (subjectInClip) {
+            result.push_back(second);
+        } else if (clipInSubject) {
+            result.push_back(first);
+        } else {
+            result.push_back(first);
+            result.push_back(second);
+        }
+        break;
+    case DIFFERENCE:
+        if (!subjectInClip) result.push_back(first);
+        if (clipInSubject) {
+            result.push_back(AlgoPolygon(std::vector<AlgoPoint>(clip.rbegin(), clip.rend())));
+        }
+        break;
+    }
+    return result;
+}
+
+bool PolygonOperationsAlgorithms::computeExactOperation(const AlgoPolygon& poly1, const AlgoPolygon& poly2,
+                                                        Operation op, std::vector<AlgoPolygon>& result) {
+    result.clear();
+    std::vector<AlgoPoint> subject = poly1.points();
+    std::vector<AlgoPoint> clip = poly2.points();
+    if (subject.size() < 3 || clip.size() < 3) {
+        if (subject.size() >= 3 && op != INTERSECTION) result.push_back(poly1);
+        if (clip.size() >= 3 && op == UNION) result.push_back(poly2);
+        return true;
+    }
+
+    if (signedArea(subject) < 0) std::reverse(subject.begin(), subject.end());
+    if (signedArea(clip) < 0) std::reverse(clip.begin(), clip.end());
+
+    double extent = 0;
+    for (const auto* poly : {&subject, &clip}) {
+        for (const auto& p : *poly) extent = std::max(extent, std::max(std::abs(p.x), std::abs(p.y)));
+    }
+
+    // При вырождении второй многоугольник сдвигается на малую величину в
+    // направлении, не совпадающем с осями, и пересечения ищутся заново.
+    // Сдвиг растёт, но не больше kMaxShift от размера; если вырождение не
+    // снимается, операция не выполняется.
+    std::vector<EdgeCrossing> crossings;
+    std::vector<AlgoPoint> shifted = clip;
+    double scale = std::max(extent, 1.0);
+    double shift = scale * 1e-9;
+    bool found = findCrossings(subject, shifted, crossings);
+    for (int attempt = 0; !found && attempt < kShiftAttempts; attempt++) {
+        shift = std::min(shift * 4, scale * kMaxShift);
+        double angle = 0.7853981 + attempt * 2.3999632;
+        AlgoPoint offset(std::cos(angle) * shift, std::sin(angle) * shift);
+        for (size_t i = 0; i < clip.size(); i++) shifted[i] = clip[i] + offset;
+        found = findCrossings(subject, shifted, crossings);
+    }
+    if (!found) return false;
+
+    if (crossings.empty()) {
+        result = disjointResult(subject, shifted, op);
+        return true;
+    }
+
+    std::vector<int> subjectNode, clipNode;
+    std::vector<ClipNode> subjectList = buildNodeList(subject, crossings, true, subjectNode);
+    std::vector<ClipNode> clipList = buildNodeList(shifted, crossings, false, clipNode);
+    for (size_t k = 0; k < crossings.size(); k++) {
+        subjectList[subjectNode[k]].neighbor = clipNode[k];
+        clipList[clipNode[k]].neighbor = subjectNode[k];
+    }
+
+    markEntries(subjectList, shifted, op != INTERSECTION);
+    markEntries(clipList, subject, op == UNION);
+    result = traverse(subjectList, clipList);
+    return true;
+}
+
+AlgoPolygon PolygonOperationsAlgorithms::mergeEdges(const std::vector<AlgoPoint>& a, const std::vector<AlgoPoint>& b) {
+    AlgoPolygon result;
+    if (a.empty() || b.empty()) return result;
+
+    if (a.size() == 1 || b.size() == 1) {
+        const std::vector<AlgoPoint>& shape = a.size() == 1 ? b : a;
+        const AlgoPoint& offset = a.size() == 1 ? a[0] : b[0];
+        for (const auto& p : shape) result.addPoint(p + offset);
+        return result;
+    }
+
+    size_t n = a.size();
+    size_t m = b.size();
+    std::vector<AlgoPoint> sum;
+    sum.reserve(n + m);
+    size_t i = 0, j = 0;
+    while (i < n || j < m) {
+        sum.push_back(a[i % n] + b[j % m]);
+        double cross = (a[(i + 1) % n] - a[i % n]).cross(b[(j + 1) % m] - b[j % m]);
+        // Параллельные рёбра сливаются в одно
+        if (cross >= 0 && i < n) i++;
+        if (cross <= 0 && j < m) j++;
+    }
+    result.setPoints(sum);
+    return result;
+}
+
+AlgoPolygon PolygonOperationsAlgorithms::minkowskiSum(const AlgoPolygon& a, const AlgoPolygon& b) {
+    return mergeEdges(a.hull(), b.hull());
+}
+
+std::vector<AlgoPolygon> PolygonOperationsAlgorithms::minkowskiSum(const std::vector<AlgoPolygon>& polygons,
+                                                                   const AlgoPolygon& shape) {
+    const std::vector<AlgoPoint>& prepared = shape.hull();
+    std::vector<AlgoPolygon> result;
+    result.reserve(polygons.size());
+    for (const auto& poly : polygons) {
+        result.push_back(mergeEdges(poly.hull(), prepared));
+    }
+    return result;
+}
+
 bool PolygonOperationsAlgorithms::isPointInsidePolygon(const AlgoPoint& p, const std::vector<AlgoPoint>& polygon) {
     if (polygon.size() < 3) return false;
 
@@ -19,16 +19,56 @@ struct AlgoPoint {
     double dist2() const { return x*x + y*y; }
 };
 
+struct AlgoBounds {
+    double minX, minY, maxX, maxY;
+    AlgoBounds() : minX(0), minY(0), maxX(0), maxY(0) {}
+};
+
+// Хранит исходные вершины, а оболочка, AABB, площадь и признак выпуклости
+// считаются лениво и кешируются до следующего изменения вершин.
+// Кеш не защищён от одновременного первого обращения из нескольких потоков.
 class AlgoPolygon {
 public:
-    std::vector<AlgoPoint> points;
+    AlgoPolygon() : cachedArea(0), cachedConvex(false), dirty(true) {}
+    explicit AlgoPolygon(const std::vector<AlgoPoint>& points)
+        : sourcePoints(points), cachedArea(0), cachedConvex(false), dirty(true) {}
 
-    void addPoint(const AlgoPoint& p) { points.push_back(p); }
-    void clear() { points.clear(); }
-    bool empty() const { return points.empty(); }
-    size_t size() const { return points.size(); }
+    void addPoint(const AlgoPoint& p) {
+        sourcePoints.push_back(p);
+        dirty = true;
+    }
+    void setPoints(const std::vector<AlgoPoint>& points) {
+        sourcePoints = points;
+        dirty = true;
+    }
+    void clear() {
+        sourcePoints.clear();
+        dirty = true;
+    }
+    bool empty() const { return sourcePoints.empty(); }
+    size_t size() const { return sourcePoints.size(); }
+    const std::vector<AlgoPoint>& points() const { return sourcePoints; }
 
+    // Выпуклая оболочка против часовой стрелки, начиная с нижней вершины
+    const std::vector<AlgoPoint>& hull() const;
+    const AlgoBounds& bounds() const;
+    // Ориентированная площадь исходного контура, положительная при обходе против часовой стрелки
+    double area() const;
+    bool isConvex() const;
+
+    // Заменяет исходные вершины выпуклой оболочкой
     void computeConvexHull();
+
+private:
+    static std::vector<AlgoPoint> buildHull(std::vector<AlgoPoint> points);
+    void update() const;
+
+    std::vector<AlgoPoint> sourcePoints;
+    mutable std::vector<AlgoPoint> cachedHull;
+    mutable AlgoBounds cachedBounds;
+    mutable double cachedArea;
+    mutable bool cachedConvex;
+    mutable bool dirty;
 };
 
 class PolygonOperationsAlgorithms {
@@ -37,7 +77,58 @@ public:
 
     static AlgoPolygon computeOperation(const AlgoPolygon& poly1, const AlgoPolygon& poly2, Operation op);
 
+    // Точная операция Грейнера–Хормана над простыми (в том числе невыпуклыми)
+    // многоугольниками. Внешние контуры результата обходятся против часовой
+    // стрелки, дыры — по часовой. Вырожденные случаи (вершина на ребре,
+    // совпадающие рёбра) снимаются сдвигом второго многоугольника не больше
+    // kMaxShift от размера; false, если вырождение так и не снялось.
+    static bool computeExactOperation(const AlgoPolygon& poly1, const AlgoPolygon& poly2,
+                                      Operation op, std::vector<AlgoPolygon>& result);
+
+    static constexpr double kMaxShift = 1e-6;
+    static constexpr int kShiftAttempts = 16;
+
+    static double signedArea(const std::vector<AlgoPoint>& polygon);
+
+    // Сумма Минковского выпуклых оболочек за O(n + m): рёбра обеих оболочек,
+    // начиная с нижней вершины, сливаются в порядке возрастания угла.
+    // Оболочки берутся из кеша многоугольников.
+    static AlgoPolygon minkowskiSum(const AlgoPolygon& a, const AlgoPolygon& b);
+    // Каждый многоугольник складывается с одной и той же фигурой, которая
+    // подготавливается один раз
+    static std::vector<AlgoPolygon> minkowskiSum(const std::vector<AlgoPolygon>& polygons,
+                                                 const AlgoPolygon& shape);
+
 private:
+    struct ClipNode {
+        AlgoPoint p;
+        int next, prev;
+        int neighbor;
+        double alpha;
+        bool intersection, entry, visited;
+        ClipNode(const AlgoPoint& p = AlgoPoint(), double alpha = 0, bool intersection = false)
+            : p(p), next(-1), prev(-1), neighbor(-1), alpha(alpha),
+              intersection(intersection), entry(false), visited(false) {}
+    };
+
+    struct EdgeCrossing {
+        int edge1, edge2;
+        double alpha1, alpha2;
+        AlgoPoint p;
+    };
+
+    static AlgoPolygon mergeEdges(const std::vector<AlgoPoint>& a, const std::vector<AlgoPoint>& b);
+
+    static bool findCrossings(const std::vector<AlgoPoint>& subject, const std::vector<AlgoPoint>& clip,
+                              std::vector<EdgeCrossing>& crossings);
+    static std::vector<ClipNode> buildNodeList(const std::vector<AlgoPoint>& polygon,
+                                               const std::vector<EdgeCrossing>& crossings, bool first,
+                                               std::vector<int>& crossingNode);
+    static void markEntries(std::vector<ClipNode>& nodes, const std::vector<AlgoPoint>& other, bool invert);
+    static std::vector<AlgoPolygon> traverse(std::vector<ClipNode>& subject, std::vector<ClipNode>& clip);
+    static std::vector<AlgoPolygon> disjointResult(const std::vector<AlgoPoint>& subject,
+                                                   const std::vector<AlgoPoint>& clip, Operation op);
+
     static AlgoPolygon computeIntersection(const AlgoPolygon& poly1, const AlgoPolygon& poly2);
     static AlgoPolygon computeUnion(const AlgoPolygon& poly1, const AlgoPolygon& poly2);
     static AlgoPolygon computeDifference(const AlgoPolygon& poly1, const AlgoPolygon& poly2);
@@ -113,7 +113,7 @@ void PolygonCanvas::paintEvent(QPaintEvent *event) {
     } else {
         drawPolygon(painter, poly1, Qt::blue, false);
         drawPolygon(painter, poly2, Qt::red, false);
-        drawPolygon(painter, result, Qt::green, true);
+        drawResult(painter, Qt::green);
     }
 }
 
@@ -150,6 +150,34 @@ void PolygonCanvas::drawPolygon(QPainter& painter, const VisualPolygon& poly, co
     }
 }
 
+void PolygonCanvas::drawResult(QPainter& painter, const QColor& color) {
+    // Дыры результата заливаются по чётно-нечётному правилу одним путём
+    QPainterPath path;
+    path.setFillRule(Qt::OddEvenFill);
+    for (const auto& poly : result) {
+        if (poly.points.size() < 3) continue;
+        QPolygonF qpoly;
+        for (const auto& p : poly.points) {
+            qpoly << p.pos;
+        }
+        path.addPolygon(qpoly);
+        path.closeSubpath();
+    }
+
+    QPen pen(color);
+    pen.setWidth(3);
+    painter.setPen(pen);
+    painter.setBrush(color.lighter(150));
+    painter.drawPath(path);
+
+    for (const auto& poly : result) {
+        for (const auto& p : poly.points) {
+            painter.setBrush(color);
+            painter.drawEllipse(p.pos, 5, 5);
+        }
+    }
+}
+
 void PolygonCanvas::computeResult() {
     AlgoPolygon algoPoly1, algoPoly2;
 
@@ -161,14 +189,17 @@ void PolygonCanvas::computeResult() {
         algoPoly2.addPoint(AlgoPoint(point.pos.x(), point.pos.y()));
     }
 
-    algoPoly1.computeConvexHull();
-    algoPoly2.computeConvexHull();
-
-    AlgoPolygon algoResult = PolygonOperationsAlgorithms::computeOperation(algoPoly1, algoPoly2, operation);
+    // Если вырождение не снялось малым сдвигом, результат не показывается
+    std::vector<AlgoPolygon> algoResult;
+    PolygonOperationsAlgorithms::computeExactOperation(algoPoly1, algoPoly2, operation, algoResult);
 
     result.clear();
-    for (const auto& point : algoResult.points) {
-        result.addPoint(VisualPoint(QPointF(point.x, point.y)));
+    for (const auto& algoPoly : algoResult) {
+        VisualPolygon poly;
+        for (const auto& point : algoPoly.points()) {
+            poly.addPoint(VisualPoint(QPointF(point.x, point.y)));
+        }
+        result.push_back(poly);
     }
 }
 
@@ -9,6 +9,7 @@
 #include <QRadioButton>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QPainterPath>
 #include <vector>
 #include "polygon_ops_algorithms.h"
 
@@ -51,9 +52,11 @@ protected:
 private:
     double distance2(const QPointF& a, const QPointF& b);
     void drawPolygon(QPainter& painter, const VisualPolygon& poly, const QColor& color, bool active);
+    void drawResult(QPainter& painter, const QColor& color);
     void computeResult();
 
-    VisualPolygon poly1, poly2, result;
+    VisualPolygon poly1, poly2;
+    std::vector<VisualPolygon> result;
     Mode mode;
     PolygonOperationsAlgorithms::Operation operation;
     int movingPoint;
@@ -0,0 +1,124 @@
+#ifndef POINT_HASH_GRID_H
+#define POINT_HASH_GRID_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+// Множество точек с допуском: две точки совпадают, если |dx| < tolerance
+// и |dy| < tolerance (как BoolPoint::operator==). Точки квантуются в ячейки
+// со стороной kCellScale * tolerance и лежат в хеш-таблице с открытой
+// адресацией — без выделения памяти на каждую вставку, в отличие от std::set.
+// Соседние ячейки проверяются, только если точка ближе tolerance к их границе.
+// Point — любой тип с полями x и y.
+template <typename Point>
+class PointHashGrid {
+public:
+    static constexpr double kCellScale = 64.0;
+
+    explicit PointHashGrid(double tolerance = 1e-9, size_t expectedPoints = 16)
+        : tolerance(tolerance), cellSize(tolerance * kCellScale), count(0) {
+        size_t capacity = 16;
+        while (capacity < expectedPoints * 2) capacity <<= 1;
+        slots.assign(capacity, Slot());
+    }
+
+    // true, если точки в пределах допуска ещё не было и она добавлена
+    bool insert(const Point& p) {
+        if (findNear(p)) return false;
+
+        if ((count + 1) * 2 > slots.size()) grow();
+        place(Slot(cellOf(p.x), cellOf(p.y), p));
+        count++;
+        return true;
+    }
+
+    bool contains(const Point& p) const {
+        return findNear(p);
+    }
+
+    void clear() {
+        for (auto& slot : slots) slot.used = false;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+
+private:
+    static constexpr long long kMaxCellIndex = 1LL << 62;
+    static constexpr double kMaxCell = 4611686018427387904.0;   // 2^62
+
+    struct Slot {
+        long long cx, cy;
+        Point point;
+        bool used;
+        Slot() : cx(0), cy(0), point(), used(false) {}
+        Slot(long long cx, long long cy, const Point& p) : cx(cx), cy(cy), point(p), used(true) {}
+    };
+
+    // Номера ячеек ограничены ±kMaxCell, чтобы приведение к long long было
+    // определено и для огромных координат, бесконечностей и NaN. Далёкие точки
+    // попадают в крайнюю ячейку; совпадение всё равно проверяется по координатам.
+    long long cellOf(double v) const {
+        double cell = std::floor(v / cellSize);
+        if (!(std::abs(cell) < kMaxCell)) return cell > 0 ? kMaxCellIndex : (cell < 0 ? -kMaxCellIndex : 0);
+        return static_cast<long long>(cell);
+    }
+
+    static size_t hashCell(long long cx, long long cy) {
+        uint64_t h = static_cast<uint64_t>(cx) * 0x9E3779B97F4A7C15ULL;
+        h ^= static_cast<uint64_t>(cy) * 0xC2B2AE3D27D4EB4FULL;
+        h ^= h >> 29;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 32;
+        return static_cast<size_t>(h);
+    }
+
+    bool findInCell(const Point& p, long long cx, long long cy) const {
+        size_t mask = slots.size() - 1;
+        for (size_t i = hashCell(cx, cy) & mask; slots[i].used; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.cx == cx && slot.cy == cy &&
+                std::abs(slot.point.x - p.x) < tolerance &&
+                std::abs(slot.point.y - p.y) < tolerance) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool findNear(const Point& p) const {
+        long long x0 = cellOf(p.x - tolerance), x1 = cellOf(p.x + tolerance);
+        long long y0 = cellOf(p.y - tolerance), y1 = cellOf(p.y + tolerance);
+        for (long long cx = x0; cx <= x1; cx++) {
+            for (long long cy = y0; cy <= y1; cy++) {
+                if (findInCell(p, cx, cy)) return true;
+            }
+        }
+        return false;
+    }
+
+    void place(const Slot& slot) {
+        size_t mask = slots.size() - 1;
+        size_t i = hashCell(slot.cx, slot.cy) & mask;
+        while (slots[i].used) i = (i + 1) & mask;
+        slots[i] = slot;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, Slot());
+        for (const auto& slot : old) {
+            if (slot.used) place(slot);
+        }
+    }
+
+    double tolerance;
+    double cellSize;
+    size_t count;
+    std::vector<Slot> slots;
+};
+
+#endif